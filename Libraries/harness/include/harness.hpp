@@ -0,0 +1,71 @@
+#ifndef HARNESS_HPP
+#define HARNESS_HPP
+
+#include <functional>
+#include <vector>
+#include <softraster.hpp>
+
+/* Headless project harness */
+
+struct HarnessSketch
+{
+    const char *name;
+    int width;
+    int height;
+    // Draws a frame into the canvas. Frames are visited in order from 0,
+    // so sketches with state can step their simulation here.
+    std::function<void(int frame, Canvas &canvas)> draw;
+};
+
+struct FrameTimes
+{
+    double mean;
+    double p50;
+    double p90;
+    double p99;
+    double max;
+};
+
+FrameTimes frame_time_percentiles(std::vector<double> times_ms);
+
+// True when the command line asks for the harness (--harness <directory>)
+bool harness_requested(int argc, char **argv);
+
+// Runs the sketch headlessly on the CPU rasterizer for a fixed number of
+// frames, compares selected frames against the golden images in the
+// harness directory and the frame times against its baseline.json.
+// Returns the process exit code: non-zero when an image differs beyond
+// the tolerance or, with --check-times, the frame time regressed beyond
+// the threshold.
+//
+// The baseline times are only a reference: they were measured on the
+// machine that last ran --update. Check them where the baselines are
+// regenerated on the same machine, like a dedicated CI runner.
+//
+//   --harness <dir>     goldens and baseline
+//   --frames <n>        frames to run (120)
+//   --every <n>         compare every n-th frame and the last one (30)
+//   --tolerance <f>     fraction of pixels allowed to differ (0.001)
+//   --threshold <f>     allowed p50/p90 slowdown over the baseline (0.25)
+//   --check-times       fail when the threshold is exceeded
+//   --report <file>     JSON report (<name>-harness.json)
+//   --update            rewrite the goldens and the baseline instead
+int harness_main(int argc, char **argv, const HarnessSketch &sketch);
+
+/* Fixed workload benchmark */
+
+// True when the command line asks for a benchmark (--bench <frames>)
+bool bench_requested(int argc, char **argv);
+
+// Seeds raylib's and the C library's random generators with a fixed seed,
+// then calls step(frame, dt) on a virtual clock where dt is always 1/60 s,
+// and prints throughput and p50/p99 frame times. The caller opens its
+// window without SetTargetFPS() or vsync so nothing waits on the display.
+//
+//   --bench <frames>    measured frames
+//   --warmup <n>        frames run before measuring (30)
+//   --seed <n>          random seed (1)
+int bench_main(int argc, char **argv, const char *name,
+               const std::function<void(int frame, float dt)> &step);
+
+#endif // HARNESS_HPP
@@ -0,0 +1,480 @@
+#include <harness.hpp>
+#include <raylib-ext/image-export.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// Two pixels differ when their YIQ distance is above this fraction of the
+// largest possible distance, the same perceptual metric as pixelmatch
+#define HARNESS_COLOR_THRESHOLD 0.1
+#define HARNESS_MAX_YIQ_DELTA 35215.0
+
+struct HarnessOptions
+{
+    std::string directory;
+    std::string report;
+    int frames = 120;
+    int every = 30;
+    double tolerance = 0.001;
+    double threshold = 0.25;
+    bool check_times = false;
+    bool update = false;
+};
+
+struct ImageResult
+{
+    int frame;
+    long different;
+    double fraction;
+    bool missing;
+    bool passed;
+};
+
+static HarnessOptions
+parse_options(int argc, char **argv, const HarnessSketch &sketch)
+{
+    HarnessOptions options;
+    options.report = std::string(sketch.name) + "-harness.json";
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (std::strcmp(arg, "--update") == 0)
+            options.update = true;
+        else if (std::strcmp(arg, "--check-times") == 0)
+            options.check_times = true;
+        else if (value == nullptr)
+            continue;
+        else if (std::strcmp(arg, "--harness") == 0)
+            options.directory = argv[++i];
+        else if (std::strcmp(arg, "--report") == 0)
+            options.report = argv[++i];
+        else if (std::strcmp(arg, "--frames") == 0)
+            options.frames = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(arg, "--every") == 0)
+            options.every = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(arg, "--tolerance") == 0)
+            options.tolerance = std::atof(argv[++i]);
+        else if (std::strcmp(arg, "--threshold") == 0)
+            options.threshold = std::atof(argv[++i]);
+    }
+
+    return options;
+}
+
+FrameTimes
+frame_time_percentiles(std::vector<double> times_ms)
+{
+    FrameTimes times = {};
+    if (times_ms.empty())
+        return times;
+
+    std::sort(times_ms.begin(), times_ms.end());
+
+    // Nearest rank
+    auto at = [&](double q) {
+        size_t rank = (size_t) std::ceil(q * times_ms.size());
+        return times_ms[std::min(std::max(rank, (size_t) 1), times_ms.size()) - 1];
+    };
+
+    double sum = 0.0;
+    for (double time : times_ms)
+        sum += time;
+
+    times.mean = sum / times_ms.size();
+    times.p50 = at(0.50);
+    times.p90 = at(0.90);
+    times.p99 = at(0.99);
+    times.max = times_ms.back();
+    return times;
+}
+
+bool
+harness_requested(int argc, char **argv)
+{
+    for (int i = 1; i < argc; ++i)
+        if (std::strcmp(argv[i], "--harness") == 0)
+            return true;
+    return false;
+}
+
+/* Golden images */
+
+static std::string
+frame_path(const std::string &directory, const std::string &prefix, int frame)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "frame-%06d.png", frame);
+    return directory + "/" + prefix + name;
+}
+
+static Image
+canvas_image(Canvas &canvas)
+{
+    return Image {
+        canvas.pixels.data(), canvas.width, canvas.height, 1,
+        PIXELFORMAT_UNCOMPRESSED_R8G8B8A8
+    };
+}
+
+static void
+yiq(Color c, double &y, double &i, double &q)
+{
+    // Blend over white like pixelmatch, so alpha differences count too
+    double a = c.a / 255.0;
+    double r = 255 + (c.r - 255) * a;
+    double g = 255 + (c.g - 255) * a;
+    double b = 255 + (c.b - 255) * a;
+
+    y = r * 0.29889531 + g * 0.58662247 + b * 0.11448223;
+    i = r * 0.59597799 - g * 0.27417610 - b * 0.32180189;
+    q = r * 0.21147017 - g * 0.52261711 + b * 0.31114694;
+}
+
+static ImageResult
+compare_frame(Canvas &canvas, int frame, const HarnessOptions &options,
+              const std::string &diff_directory, const std::string &diff_prefix)
+{
+    ImageResult result = { frame, 0, 0.0, false, false };
+    const long pixel_count = (long) canvas.pixels.size();
+
+    Image expected = LoadImage(frame_path(options.directory, "", frame).c_str());
+    if (expected.data == nullptr)
+    {
+        result.missing = true;
+        return result;
+    }
+
+    if (expected.width != canvas.width || expected.height != canvas.height)
+    {
+        UnloadImage(expected);
+        result.different = pixel_count;
+        result.fraction = 1.0;
+        return result;
+    }
+
+    ImageFormat(&expected, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    const Color *golden = (const Color *) expected.data;
+    const double max_delta = HARNESS_MAX_YIQ_DELTA
+                           * HARNESS_COLOR_THRESHOLD * HARNESS_COLOR_THRESHOLD;
+
+    // Differences in red over a faded copy of the frame
+    std::vector<Color> diff(canvas.pixels.size());
+
+    for (long p = 0; p < pixel_count; ++p)
+    {
+        double y1, i1, q1, y2, i2, q2;
+        yiq(canvas.pixels[p], y1, i1, q1);
+        yiq(golden[p], y2, i2, q2);
+
+        double dy = y1 - y2, di = i1 - i2, dq = q1 - q2;
+        double delta = 0.5053 * dy * dy + 0.299 * di * di + 0.1957 * dq * dq;
+
+        if (delta > max_delta)
+        {
+            ++result.different;
+            diff[p] = RED;
+        }
+        else
+        {
+            unsigned char gray = (unsigned char) (255 + (y2 - 255) * 0.1);
+            diff[p] = Color { gray, gray, gray, 255 };
+        }
+    }
+
+    UnloadImage(expected);
+
+    result.fraction = (double) result.different / pixel_count;
+    result.passed = result.fraction <= options.tolerance;
+
+    if (!result.passed)
+    {
+        Image image = {
+            diff.data(), canvas.width, canvas.height, 1,
+            PIXELFORMAT_UNCOMPRESSED_R8G8B8A8
+        };
+        ExportImageParallel(image, frame_path(diff_directory, diff_prefix, frame), 1);
+    }
+
+    return result;
+}
+
+/* Frame time baseline */
+
+static bool
+json_number(const std::string &text, const char *key, double &value)
+{
+    size_t at = text.find(std::string("\"") + key + "\"");
+    if (at == std::string::npos)
+        return false;
+
+    at = text.find(':', at);
+    return at != std::string::npos && std::sscanf(text.c_str() + at + 1, "%lf", &value) == 1;
+}
+
+static bool
+load_baseline(const std::string &path, FrameTimes &times)
+{
+    std::ifstream file(path);
+    if (!file)
+        return false;
+
+    std::stringstream text;
+    text << file.rdbuf();
+
+    // Only p50 and p90 are checked, the rest is informational
+    json_number(text.str(), "mean", times.mean);
+    json_number(text.str(), "p99", times.p99);
+    json_number(text.str(), "max", times.max);
+    return json_number(text.str(), "p50", times.p50)
+        && json_number(text.str(), "p90", times.p90);
+}
+
+static void
+write_times(FILE *file, const char *key, const FrameTimes &times, const char *suffix)
+{
+    std::fprintf(file,
+                 "  \"%s\": { \"mean\": %.4f, \"p50\": %.4f, \"p90\": %.4f, "
+                 "\"p99\": %.4f, \"max\": %.4f }%s\n",
+                 key, times.mean, times.p50, times.p90, times.p99, times.max, suffix);
+}
+
+static bool
+write_baseline(const std::string &path, const HarnessSketch &sketch,
+               const HarnessOptions &options, const FrameTimes &times)
+{
+    FILE *file = std::fopen(path.c_str(), "w");
+    if (file == nullptr)
+        return false;
+
+    std::fprintf(file, "{\n");
+    std::fprintf(file, "  \"name\": \"%s\",\n", sketch.name);
+    std::fprintf(file, "  \"frames\": %d,\n", options.frames);
+    std::fprintf(file, "  \"width\": %d,\n", sketch.width);
+    std::fprintf(file, "  \"height\": %d,\n", sketch.height);
+    write_times(file, "frame_ms", times, "");
+    std::fprintf(file, "}\n");
+    std::fclose(file);
+    return true;
+}
+
+static bool
+write_report(const std::string &path, const HarnessSketch &sketch,
+             const HarnessOptions &options, const FrameTimes &times,
+             const FrameTimes *baseline, bool time_passed,
+             const std::vector<ImageResult> &images, bool passed)
+{
+    FILE *file = std::fopen(path.c_str(), "w");
+    if (file == nullptr)
+        return false;
+
+    std::fprintf(file, "{\n");
+    std::fprintf(file, "  \"name\": \"%s\",\n", sketch.name);
+    std::fprintf(file, "  \"frames\": %d,\n", options.frames);
+    std::fprintf(file, "  \"width\": %d,\n", sketch.width);
+    std::fprintf(file, "  \"height\": %d,\n", sketch.height);
+    write_times(file, "frame_ms", times, ",");
+    if (baseline != nullptr)
+        write_times(file, "baseline_ms", *baseline, ",");
+    std::fprintf(file, "  \"threshold\": %.4f,\n", options.threshold);
+    std::fprintf(file, "  \"time_passed\": %s,\n", time_passed ? "true" : "false");
+    std::fprintf(file, "  \"tolerance\": %.6f,\n", options.tolerance);
+    std::fprintf(file, "  \"images\": [\n");
+    for (size_t i = 0; i < images.size(); ++i)
+    {
+        const ImageResult &image = images[i];
+        std::fprintf(file,
+                     "    { \"frame\": %d, \"missing\": %s, \"different_pixels\": %ld, "
+                     "\"fraction\": %.6f, \"passed\": %s }%s\n",
+                     image.frame, image.missing ? "true" : "false", image.different,
+                     image.fraction, image.passed ? "true" : "false",
+                     i + 1 < images.size() ? "," : "");
+    }
+    std::fprintf(file, "  ],\n");
+    std::fprintf(file, "  \"passed\": %s\n", passed ? "true" : "false");
+    std::fprintf(file, "}\n");
+    std::fclose(file);
+    return true;
+}
+
+int
+harness_main(int argc, char **argv, const HarnessSketch &sketch)
+{
+    SetTraceLogLevel(LOG_WARNING);
+
+    HarnessOptions options = parse_options(argc, argv, sketch);
+    if (options.directory.empty())
+    {
+        std::fprintf(stderr, "%s: --harness needs a directory\n", sketch.name);
+        return 2;
+    }
+
+    std::error_code error;
+    std::filesystem::path report_path(options.report);
+    std::string report_directory = report_path.has_parent_path()
+        ? report_path.parent_path().string() : std::string(".");
+    std::filesystem::create_directories(report_directory, error);
+    if (options.update)
+        std::filesystem::create_directories(options.directory, error);
+
+    // One thread, so frame times don't depend on the machine's core count
+    Canvas canvas(sketch.width, sketch.height, 1);
+    std::vector<double> times_ms;
+    times_ms.reserve(options.frames);
+    std::vector<ImageResult> images;
+    bool passed = true;
+
+    for (int frame = 0; frame < options.frames; ++frame)
+    {
+        auto start = std::chrono::steady_clock::now();
+        sketch.draw(frame, canvas);
+        canvas.flush();
+        times_ms.push_back(std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start
+        ).count());
+
+        if (frame % options.every != 0 && frame != options.frames - 1)
+            continue;
+
+        if (options.update)
+        {
+            std::string path = frame_path(options.directory, "", frame);
+            if (!ExportImageParallel(canvas_image(canvas), path, 1))
+            {
+                std::fprintf(stderr, "%s: can't write %s\n", sketch.name, path.c_str());
+                passed = false;
+            }
+            continue;
+        }
+
+        // Diff images go next to the report, named after the sketch
+        ImageResult result = compare_frame(canvas, frame, options, report_directory,
+                                           std::string(sketch.name) + "-diff-");
+        if (result.missing)
+            std::printf("%s: frame %d has no golden image, run with --update\n",
+                        sketch.name, frame);
+        else if (!result.passed)
+            std::printf("%s: frame %d differs in %ld pixels (%.4f%% > %.4f%%)\n",
+                        sketch.name, frame, result.different,
+                        result.fraction * 100, options.tolerance * 100);
+
+        passed = passed && result.passed;
+        images.push_back(result);
+    }
+
+    FrameTimes times = frame_time_percentiles(times_ms);
+    std::string baseline_path = options.directory + "/baseline.json";
+
+    if (options.update)
+    {
+        if (!write_baseline(baseline_path, sketch, options, times))
+        {
+            std::fprintf(stderr, "%s: can't write %s\n", sketch.name, baseline_path.c_str());
+            passed = false;
+        }
+        std::printf("%s: updated goldens and baseline (p50 %.3f ms, p90 %.3f ms)\n",
+                    sketch.name, times.p50, times.p90);
+        return passed ? 0 : 1;
+    }
+
+    FrameTimes baseline = {};
+    bool has_baseline = load_baseline(baseline_path, baseline);
+    bool time_passed = true;
+    if (has_baseline)
+    {
+        double limit = 1.0 + options.threshold;
+        time_passed = times.p50 <= baseline.p50 * limit && times.p90 <= baseline.p90 * limit;
+    }
+    else
+    {
+        std::printf("%s: no baseline.json, frame times are not checked\n", sketch.name);
+    }
+
+    // Baselines come from whatever machine last ran --update, so a slower
+    // one only fails when asked to
+    if (options.check_times)
+        passed = passed && time_passed;
+    else if (!time_passed)
+        std::printf("%s: frame times are over the baseline by more than %.0f%%, "
+                    "not checked without --check-times\n",
+                    sketch.name, options.threshold * 100);
+
+    write_report(options.report, sketch, options, times,
+                 has_baseline ? &baseline : nullptr, time_passed, images, passed);
+
+    std::printf("%s: %d frames, p50 %.3f ms, p90 %.3f ms, p99 %.3f ms",
+                sketch.name, options.frames, times.p50, times.p90, times.p99);
+    if (has_baseline)
+        std::printf(" (baseline p50 %.3f ms, p90 %.3f ms)", baseline.p50, baseline.p90);
+    std::printf(": %s\n", passed ? "passed" : "FAILED");
+
+    return passed ? 0 : 1;
+}
+
+/* Fixed workload benchmark */
+
+bool
+bench_requested(int argc, char **argv)
+{
+    for (int i = 1; i < argc; ++i)
+        if (std::strcmp(argv[i], "--bench") == 0)
+            return true;
+    return false;
+}
+
+int
+bench_main(int argc, char **argv, const char *name,
+           const std::function<void(int frame, float dt)> &step)
+{
+    const float dt = 1.0f / 60.0f;
+    int frames = 600;
+    int warmup = 30;
+    unsigned int seed = 1;
+
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--bench") == 0)
+            frames = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--warmup") == 0)
+            warmup = std::max(0, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--seed") == 0)
+            seed = (unsigned int) std::strtoul(argv[++i], nullptr, 10);
+    }
+
+    SetRandomSeed(seed);
+    std::srand(seed);
+
+    for (int frame = 0; frame < warmup; ++frame)
+        step(frame, dt);
+
+    std::vector<double> times_ms;
+    times_ms.reserve(frames);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = warmup; frame < warmup + frames; ++frame)
+    {
+        auto frame_start = std::chrono::steady_clock::now();
+        step(frame, dt);
+        times_ms.push_back(std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - frame_start
+        ).count());
+    }
+    double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start
+    ).count();
+
+    FrameTimes times = frame_time_percentiles(times_ms);
+    std::printf("%s: %d frames in %.3f s, %.1f frames/s, p50 %.3f ms, p99 %.3f ms\n",
+                name, frames, seconds, frames / seconds, times.p50, times.p99);
+    return 0;
+}
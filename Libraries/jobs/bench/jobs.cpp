@@ -0,0 +1,67 @@
+#include <jobs.hpp>
+#include <raylib-ext/bench.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Times-table chord end points, a few transcendentals per item
+static void
+chord_points(std::vector<float> &points, int first, int last, float multiple)
+{
+    const float theta = 6.2831853f / (points.size() / 4);
+    for (int n = first; n < last; ++n)
+    {
+        float a = theta * n;
+        float b = theta * multiple * n;
+        points[n * 4 + 0] = std::cos(a);
+        points[n * 4 + 1] = std::sin(a);
+        points[n * 4 + 2] = std::cos(b);
+        points[n * 4 + 3] = std::sin(b);
+    }
+}
+
+// Usage: bench-jobs [items] [grain]
+int main(int argc, char **argv)
+{
+    const int items = argc > 1 ? std::atoi(argv[1]) : 1 << 20;
+    const int grain = argc > 2 ? std::atoi(argv[2]) : 0;
+    const int frames = 20;
+    const int tiny_jobs = 100000;
+
+    std::vector<float> points(items * 4);
+    double single = 0.0;
+
+    for (int threads : BenchThreadCounts())
+    {
+        JobPool pool(threads);
+        auto fill = [&](int first, int last) {
+            chord_points(points, first, last, 2.0f);
+        };
+        parallel_for(pool, 0, items, grain, fill);
+
+        double start = BenchNowMs();
+        for (int frame = 0; frame < frames; ++frame)
+            parallel_for(pool, 0, items, grain, fill);
+        double frame_ms = (BenchNowMs() - start) / frames;
+
+        if (threads == 1)
+            single = frame_ms;
+
+        // Submit and run cost of jobs that do next to nothing
+        std::atomic<int> sum(0);
+        start = BenchNowMs();
+        {
+            TaskGroup group(pool);
+            for (int i = 0; i < tiny_jobs; ++i)
+                group.run([&sum] { sum.fetch_add(1, std::memory_order_relaxed); });
+        }
+        double job_ns = (BenchNowMs() - start) * 1e6 / tiny_jobs;
+
+        std::printf("threads %2d   %d items   %8.2f ms/frame (%4.1fx)   %6.1f ns/job\n",
+                    threads, items, frame_ms, single / frame_ms, job_ns);
+    }
+
+    return 0;
+}
@@ -0,0 +1,265 @@
+#ifndef JOBS_HPP
+#define JOBS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#define JOB_STORAGE_SIZE 64     // bytes of captures a job carries inline
+#define JOB_QUEUE_SIZE   4096   // jobs in flight per submitting thread
+
+struct JobCounter;
+struct JobPool;
+
+struct Job
+{
+    void (*function)(Job &job);     // runs and destroys the stored callable
+    JobCounter *counter;            // signalled when the job is done
+    Job *next;                      // in the dependents of a counter
+    std::atomic<bool> in_use;
+    alignas(std::max_align_t) unsigned char storage[JOB_STORAGE_SIZE];
+};
+
+/* Dependency counter */
+
+// Number of unfinished jobs. JobPool::wait() blocks on it and
+// JobPool::run_after() holds jobs back until it drops to zero.
+//
+// A counter is armed by the thread that runs jobs on it; other threads may
+// wait on it or add dependents. It must outlive its jobs and dependents.
+struct JobCounter
+{
+    JobCounter() = default;
+    JobCounter(const JobCounter &) = delete;
+    JobCounter& operator=(const JobCounter &) = delete;
+
+    bool done() const;
+    int pending() const;
+
+private:
+    friend struct JobPool;
+
+    std::atomic<int> count { 0 };
+    // Jobs to start at zero; closed() while the counter is at zero
+    std::atomic<Job *> dependents { closed() };
+
+    static Job *closed() { return (Job *) uintptr_t(1); }
+};
+
+/* Task group */
+
+// Jobs that are waited on together; the destructor waits too
+struct TaskGroup
+{
+    JobPool &pool;
+    JobCounter counter;
+
+    TaskGroup(JobPool &pool) : pool(pool) {}
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup& operator=(const TaskGroup &) = delete;
+    ~TaskGroup() { wait(); }
+
+    template <typename F>
+    void run(F &&function);
+
+    void wait();
+};
+
+/* Job pool */
+
+// Work-stealing thread pool. Every pool thread owns a Chase-Lev deque: it
+// pushes and pops its own jobs at the bottom while idle threads steal from
+// the top of the others, so nested jobs stay on the cache that made them.
+// The thread that creates the pool is one of its threads: it submits to
+// its own deque and runs jobs while it waits. Jobs submitted from threads
+// outside the pool run inline.
+//
+// Jobs carry their callable inline (up to JOB_STORAGE_SIZE bytes, capture
+// big things by reference) in a per-thread ring, so submitting does not
+// allocate. When the ring is full, run() calls the function inline.
+//
+// frame is a group for per-frame work: start it after Clock::tick() (or
+// before BeginDrawing()), and call frame.wait() before drawing what it
+// computes. EndFrame() waits on it as well, so no frame job outlives its
+// frame.
+struct JobPool
+{
+    TaskGroup frame;
+
+    // threads = 0 uses every hardware thread, the calling one included
+    explicit JobPool(int threads = 0);
+    JobPool(const JobPool &) = delete;
+    JobPool& operator=(const JobPool &) = delete;
+    ~JobPool();
+
+    int thread_count() const;
+
+    template <typename F>
+    void run(JobCounter &counter, F &&function);
+
+    // Starts function once dependency is done
+    template <typename F>
+    void run_after(JobCounter &dependency, JobCounter &counter, F &&function);
+
+    // Runs jobs until counter is done
+    void wait(JobCounter &counter);
+
+    // Runs one queued job, if there is one, for threads of the pool that
+    // wait on something else than a counter
+    bool help();
+
+private:
+    struct Queue;
+
+    std::vector<std::unique_ptr<Queue>> queues;    // 0 is the creating thread
+    std::vector<std::thread> workers;
+
+    std::atomic<bool> stopping;
+    std::atomic<uint64_t> epoch;    // bumped by every submit
+    std::atomic<int> sleepers;
+    std::mutex mutex;
+    std::condition_variable wake_cv;
+
+    template <typename F>
+    Job *prepare(JobCounter &counter, F &&function);
+
+    Queue *this_queue();
+    Job *allocate_job();
+    void arm(JobCounter &counter);
+    void submit(Job *job);
+    void defer(JobCounter &dependency, Job *job);
+    Job *find_job(Queue &self);
+    void execute(Job *job);
+    void worker_loop(int index);
+};
+
+template <typename F>
+Job *
+JobPool::prepare(JobCounter &counter, F &&function)
+{
+    typedef typename std::decay<F>::type Function;
+    static_assert(sizeof(Function) <= JOB_STORAGE_SIZE,
+                  "job captures are too big, capture by reference");
+    static_assert(alignof(Function) <= alignof(std::max_align_t),
+                  "job captures are over-aligned");
+
+    Job *job = allocate_job();
+    if (job == nullptr)
+        return nullptr;
+
+    new (job->storage) Function(std::forward<F>(function));
+    job->function = [](Job &job) {
+        Function *stored = std::launder((Function *) job.storage);
+        (*stored)();
+        stored->~Function();
+    };
+    job->counter = &counter;
+    arm(counter);
+    return job;
+}
+
+template <typename F>
+void
+JobPool::run(JobCounter &counter, F &&function)
+{
+    Job *job = prepare(counter, std::forward<F>(function));
+    if (job == nullptr)
+        function();
+    else
+        submit(job);
+}
+
+template <typename F>
+void
+JobPool::run_after(JobCounter &dependency, JobCounter &counter, F &&function)
+{
+    Job *job = prepare(counter, std::forward<F>(function));
+    if (job != nullptr)
+    {
+        defer(dependency, job);
+        return;
+    }
+
+    wait(dependency);
+    function();
+}
+
+template <typename F>
+void
+TaskGroup::run(F &&function)
+{
+    this->pool.run(this->counter, std::forward<F>(function));
+}
+
+/* Parallel for */
+
+template <typename F>
+void
+parallel_for_range(JobPool &pool, JobCounter &counter, int begin, int end, int grain,
+                   const F *function)
+{
+    // Hand the upper halves to thieves, keep splitting the lower one
+    while (end - begin > grain)
+    {
+        int middle = begin + (end - begin) / 2;
+        pool.run(counter, [&pool, &counter, middle, end, grain, function] {
+            parallel_for_range(pool, counter, middle, end, grain, function);
+        });
+        end = middle;
+    }
+    (*function)(begin, end);
+}
+
+inline int
+parallel_for_grain(JobPool &pool, int begin, int end, int grain)
+{
+    // About 8 ranges per thread leaves room to balance uneven ranges
+    if (grain <= 0)
+        grain = (end - begin) / (pool.thread_count() * 8);
+    return std::max(grain, 1);
+}
+
+// Calls function(first, last) on ranges of at most grain items that cover
+// [begin, end), in parallel, and returns when all of them are done.
+// grain <= 0 picks one from the thread count.
+template <typename F>
+void
+parallel_for(JobPool &pool, int begin, int end, int grain, const F &function)
+{
+    if (begin >= end)
+        return;
+
+    JobCounter counter;
+    grain = parallel_for_grain(pool, begin, end, grain);
+    parallel_for_range(pool, counter, begin, end, grain, &function);
+    pool.wait(counter);
+}
+
+// Same, without waiting: the ranges are added to group, and function must
+// stay alive until the group has been waited on
+template <typename F>
+void
+parallel_for(TaskGroup &group, int begin, int end, int grain, const F &function)
+{
+    if (begin >= end)
+        return;
+
+    JobPool &pool = group.pool;
+    JobCounter &counter = group.counter;
+    const F *callable = &function;
+    grain = parallel_for_grain(pool, begin, end, grain);
+    group.run([&pool, &counter, begin, end, grain, callable] {
+        parallel_for_range(pool, counter, begin, end, grain, callable);
+    });
+}
+
+#endif // JOBS_HPP
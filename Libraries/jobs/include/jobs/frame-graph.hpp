@@ -0,0 +1,142 @@
+#ifndef JOBS_FRAME_GRAPH_HPP
+#define JOBS_FRAME_GRAPH_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+#include <jobs.hpp>
+
+/* Resources and accesses */
+
+typedef int FrameResource;
+
+enum FrameAccessMode
+{
+    FRAME_READ,
+    FRAME_WRITE,
+    FRAME_READ_PREVIOUS,    // the buffer the previous frame wrote
+};
+
+struct FrameAccess
+{
+    FrameResource resource;
+    FrameAccessMode mode;
+};
+
+inline FrameAccess frame_reads(FrameResource resource) { return { resource, FRAME_READ }; }
+inline FrameAccess frame_writes(FrameResource resource) { return { resource, FRAME_WRITE }; }
+inline FrameAccess frame_reads_previous(FrameResource resource) { return { resource, FRAME_READ_PREVIOUS }; }
+
+enum FrameTaskFlags
+{
+    FRAME_TASK_MAIN_THREAD = 1,     // runs on the thread that calls run(), for GL and window calls
+    FRAME_TASK_DEFERRED    = 2,     // runs one frame late, next to the following frame
+};
+
+/* Frame graph */
+
+struct FrameGraphTiming
+{
+    double wall_ms;         // run() from start to end
+    double critical_ms;     // longest chain of dependent tasks
+    double work_ms;         // every task added up
+};
+
+// A frame as tasks that declare the resources they read and write. The
+// graph orders tasks that touch the same buffer of a resource, at least one
+// of them writing, in declaration order; the others run at the same time,
+// on the pool or, for FRAME_TASK_MAIN_THREAD, on the thread calling run().
+//
+// Stages overlap across frames through FRAME_TASK_DEFERRED: run(frame) runs
+// the deferred tasks of frame - 1 with the others of frame. A deferred task
+// comes after every task of its own frame whatever the declaration order,
+// so with a resource written by the simulation in two buffers, the next
+// simulation runs while a deferred task still reads the last one:
+//
+//     FrameResource state = graph.add_resource("state", 2);
+//     graph.add_task("simulate", { frame_reads_previous(state), frame_writes(state) },
+//                    [&](uint64_t frame) { step(states[graph.buffer(state, frame - 1)],
+//                                               states[graph.buffer(state, frame)]); });
+//     graph.add_task("present", { frame_reads(state) },
+//                    [&](uint64_t frame) { present(states[graph.buffer(state, frame)]); },
+//                    FRAME_TASK_MAIN_THREAD | FRAME_TASK_DEFERRED);
+//
+// The schedule is built once, by compile() or the first run(); running it
+// again does not allocate. run() is called from the thread that made the
+// pool and returns when every task it started is done, so a task function
+// only gets called with a frame once.
+struct FrameGraph
+{
+    explicit FrameGraph(JobPool &pool);
+    FrameGraph(const FrameGraph &) = delete;
+    FrameGraph& operator=(const FrameGraph &) = delete;
+
+    // buffers > 1 gives frames their own buffer, round robin
+    FrameResource add_resource(const char *name, int buffers = 1);
+
+    // function is called with the frame the task belongs to
+    int add_task(const char *name, std::initializer_list<FrameAccess> accesses,
+                 std::function<void(uint64_t frame)> function, int flags = 0);
+
+    void compile();
+    void run(uint64_t frame);
+
+    // Buffer of resource a frame uses
+    int buffer(FrameResource resource, uint64_t frame) const;
+
+    // Times of the last run()
+    const FrameGraphTiming &timing() const;
+    double task_ms(int task) const;
+    const char *task_name(int task) const;
+    int task_count() const;
+    // Tasks of the longest chain, first to last
+    const std::vector<int> &critical_path() const;
+
+private:
+    struct Resource
+    {
+        const char *name;
+        int buffers;
+    };
+
+    struct Task
+    {
+        const char *name;
+        std::function<void(uint64_t frame)> function;
+        int flags;
+        std::vector<FrameAccess> accesses;
+        std::vector<int> predecessors;
+        std::vector<int> successors;
+    };
+
+    JobPool &pool;
+    JobCounter running;
+    std::vector<Resource> resources;
+    std::vector<Task> tasks;
+    bool compiled;
+
+    // Built by compile()
+    std::vector<int> order;                 // topological, earliest declared first
+    std::vector<int> main_order;            // main thread tasks in order
+    std::vector<int> roots;                 // pool tasks that start the run
+    std::unique_ptr<std::atomic<int>[]> remaining;
+    std::vector<char> active;
+    std::vector<uint64_t> start_ns;
+    std::vector<uint64_t> end_ns;
+    std::vector<double> path_ms;
+    std::vector<int> path_previous;
+    std::vector<int> critical;
+
+    uint64_t frame;
+    FrameGraphTiming last_timing;
+
+    bool conflicts(const Task &before, const Task &after) const;
+    void launch(int task);
+    void execute(int task);
+    void update_timing(uint64_t start, uint64_t end);
+};
+
+#endif // JOBS_FRAME_GRAPH_HPP
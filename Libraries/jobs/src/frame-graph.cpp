@@ -0,0 +1,310 @@
+#include <jobs/frame-graph.hpp>
+#include <raylib-ext.hpp>
+#include <raylib-ext/profiler.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+static uint64_t
+now_ns()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(
+        steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+// Frames behind the one run() is called with
+static int
+task_lag(int flags)
+{
+    return (flags & FRAME_TASK_DEFERRED) ? 1 : 0;
+}
+
+FrameGraph::FrameGraph(JobPool &pool) :
+    pool(pool),
+    compiled(false),
+    frame(0),
+    last_timing({})
+{
+}
+
+FrameResource
+FrameGraph::add_resource(const char *name, int buffers)
+{
+    this->resources.push_back({ name, std::max(1, buffers) });
+    this->compiled = false;
+    return FrameResource(this->resources.size() - 1);
+}
+
+int
+FrameGraph::add_task(const char *name, std::initializer_list<FrameAccess> accesses,
+                     std::function<void(uint64_t frame)> function, int flags)
+{
+    for (const FrameAccess &access : accesses)
+    {
+        if (access.resource < 0 || access.resource >= (int) this->resources.size())
+            TraceLog(LOG_WARNING, "FRAME GRAPH: Task %s uses an unknown resource", name);
+        else if (access.mode == FRAME_READ_PREVIOUS &&
+                 this->resources[access.resource].buffers < 2)
+            TraceLog(LOG_WARNING, "FRAME GRAPH: Task %s reads the previous %s, which has one buffer",
+                     name, this->resources[access.resource].name);
+    }
+
+    this->tasks.push_back({ name, std::move(function), flags, accesses, {}, {} });
+    this->compiled = false;
+    return int(this->tasks.size() - 1);
+}
+
+int
+FrameGraph::buffer(FrameResource resource, uint64_t frame) const
+{
+    return int(frame % uint64_t(this->resources[resource].buffers));
+}
+
+// Both tasks run in the same run(), before first. They touch the same
+// buffer when the frames they belong to, counting the previous frame for
+// FRAME_READ_PREVIOUS, are a multiple of the buffer count apart.
+bool
+FrameGraph::conflicts(const Task &before, const Task &after) const
+{
+    for (const FrameAccess &a : before.accesses)
+    {
+        for (const FrameAccess &b : after.accesses)
+        {
+            if (a.resource != b.resource || a.resource < 0 ||
+                a.resource >= (int) this->resources.size())
+                continue;
+            if (a.mode != FRAME_WRITE && b.mode != FRAME_WRITE)
+                continue;
+
+            int a_age = task_lag(before.flags) + (a.mode == FRAME_READ_PREVIOUS);
+            int b_age = task_lag(after.flags) + (b.mode == FRAME_READ_PREVIOUS);
+            if ((a_age - b_age) % this->resources[a.resource].buffers == 0)
+                return true;
+        }
+    }
+    return false;
+}
+
+void
+FrameGraph::compile()
+{
+    const int count = (int) this->tasks.size();
+
+    for (Task &task : this->tasks)
+    {
+        task.predecessors.clear();
+        task.successors.clear();
+    }
+
+    // Older frames first, then declaration order; every edge goes forward
+    // in that order, so the graph has no cycles
+    std::vector<int> sequence(count);
+    for (int i = 0; i < count; ++i)
+        sequence[i] = i;
+    std::stable_sort(sequence.begin(), sequence.end(), [&](int a, int b) {
+        return task_lag(this->tasks[a].flags) > task_lag(this->tasks[b].flags);
+    });
+
+    for (int i = 0; i < count; ++i)
+    {
+        for (int j = i + 1; j < count; ++j)
+        {
+            Task &before = this->tasks[sequence[i]];
+            Task &after = this->tasks[sequence[j]];
+            if (conflicts(before, after))
+            {
+                before.successors.push_back(sequence[j]);
+                after.predecessors.push_back(sequence[i]);
+            }
+        }
+    }
+
+    // Kahn's algorithm taking the earliest declared ready task, so main
+    // thread tasks of the new frame go before deferred ones they don't need
+    std::vector<int> waiting(count);
+    for (int i = 0; i < count; ++i)
+        waiting[i] = (int) this->tasks[i].predecessors.size();
+
+    this->order.clear();
+    this->main_order.clear();
+    std::vector<char> done(count, 0);
+    for (int n = 0; n < count; ++n)
+    {
+        int next = 0;
+        while (done[next] || waiting[next] > 0)
+            ++next;
+
+        done[next] = 1;
+        this->order.push_back(next);
+        if (this->tasks[next].flags & FRAME_TASK_MAIN_THREAD)
+            this->main_order.push_back(next);
+        for (int successor : this->tasks[next].successors)
+            --waiting[successor];
+    }
+
+    this->remaining.reset(new std::atomic<int>[count]);
+    this->active.assign(count, 0);
+    this->start_ns.assign(count, 0);
+    this->end_ns.assign(count, 0);
+    this->path_ms.assign(count, 0.0);
+    this->path_previous.assign(count, -1);
+    this->roots.clear();
+    this->roots.reserve(count);
+    this->critical.clear();
+    this->critical.reserve(count);
+    this->compiled = true;
+}
+
+void
+FrameGraph::launch(int task)
+{
+    this->pool.run(this->running, [this, task] { execute(task); });
+}
+
+void
+FrameGraph::execute(int index)
+{
+    Task &task = this->tasks[index];
+
+    this->start_ns[index] = now_ns();
+    {
+        PROFILE_SCOPE(task.name);
+        task.function(this->frame - task_lag(task.flags));
+    }
+    this->end_ns[index] = now_ns();
+
+    for (int successor : task.successors)
+    {
+        if (!this->active[successor])
+            continue;
+        if (this->remaining[successor].fetch_sub(1, std::memory_order_acq_rel) == 1 &&
+            !(this->tasks[successor].flags & FRAME_TASK_MAIN_THREAD))
+            launch(successor);
+    }
+}
+
+void
+FrameGraph::run(uint64_t frame)
+{
+    PROFILE_SCOPE("FrameGraph::run");
+
+    if (!this->compiled)
+        compile();
+
+    const uint64_t start = now_ns();
+    const int count = (int) this->tasks.size();
+    this->frame = frame;
+
+    // Deferred tasks have nothing to do until there is a previous frame
+    for (int i = 0; i < count; ++i)
+        this->active[i] = uint64_t(task_lag(this->tasks[i].flags)) <= frame;
+
+    // Counts are all set before the first launch, the roots picked before
+    // a finishing task can launch one of them
+    this->roots.clear();
+    for (int i : this->order)
+    {
+        int waiting = 0;
+        for (int predecessor : this->tasks[i].predecessors)
+            waiting += this->active[predecessor];
+        this->remaining[i].store(waiting, std::memory_order_relaxed);
+
+        if (this->active[i] && waiting == 0 && !(this->tasks[i].flags & FRAME_TASK_MAIN_THREAD))
+            this->roots.push_back(i);
+    }
+
+    for (int i : this->roots)
+        launch(i);
+
+    for (int i : this->main_order)
+    {
+        if (!this->active[i])
+            continue;
+
+        while (this->remaining[i].load(std::memory_order_acquire) != 0)
+        {
+            if (!this->pool.help())
+                std::this_thread::yield();
+        }
+        execute(i);
+    }
+
+    this->pool.wait(this->running);
+    update_timing(start, now_ns());
+}
+
+void
+FrameGraph::update_timing(uint64_t start, uint64_t end)
+{
+    FrameGraphTiming &timing = this->last_timing;
+    timing.wall_ms = (end - start) / 1e6;
+    timing.critical_ms = 0.0;
+    timing.work_ms = 0.0;
+
+    int last = -1;
+    for (int i : this->order)
+    {
+        this->path_ms[i] = 0.0;
+        this->path_previous[i] = -1;
+        if (!this->active[i])
+            continue;
+
+        for (int predecessor : this->tasks[i].predecessors)
+        {
+            if (this->active[predecessor] && this->path_ms[predecessor] > this->path_ms[i])
+            {
+                this->path_ms[i] = this->path_ms[predecessor];
+                this->path_previous[i] = predecessor;
+            }
+        }
+
+        double task = task_ms(i);
+        this->path_ms[i] += task;
+        timing.work_ms += task;
+        if (this->path_ms[i] > timing.critical_ms)
+        {
+            timing.critical_ms = this->path_ms[i];
+            last = i;
+        }
+    }
+
+    this->critical.clear();
+    for (int i = last; i >= 0; i = this->path_previous[i])
+        this->critical.push_back(i);
+    std::reverse(this->critical.begin(), this->critical.end());
+}
+
+const FrameGraphTiming &
+FrameGraph::timing() const
+{
+    return this->last_timing;
+}
+
+double
+FrameGraph::task_ms(int task) const
+{
+    if (!this->compiled || !this->active[task])
+        return 0.0;
+    return (this->end_ns[task] - this->start_ns[task]) / 1e6;
+}
+
+const char *
+FrameGraph::task_name(int task) const
+{
+    return this->tasks[task].name;
+}
+
+int
+FrameGraph::task_count() const
+{
+    return (int) this->tasks.size();
+}
+
+const std::vector<int> &
+FrameGraph::critical_path() const
+{
+    return this->critical;
+}
@@ -0,0 +1,367 @@
+#include <jobs.hpp>
+#include <raylib-ext/frame.hpp>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <emmintrin.h>
+#define JOBS_PAUSE() _mm_pause()
+#else
+#define JOBS_PAUSE() std::this_thread::yield()
+#endif
+
+// Rounds a pool thread looks for work before it goes to sleep
+#define JOBS_SPIN_ROUNDS 64
+
+static_assert((JOB_QUEUE_SIZE & (JOB_QUEUE_SIZE - 1)) == 0,
+              "JOB_QUEUE_SIZE must be a power of two");
+
+// Chase-Lev deque with the C11 memory orders of Le, Pop, Cohen and Zappa
+// Nardelli, "Correct and Efficient Work-Stealing for Weak Memory Models".
+// It does not grow: a full deque runs the job inline instead.
+struct JobPool::Queue
+{
+    alignas(64) std::atomic<int64_t> top { 0 };
+    alignas(64) std::atomic<int64_t> bottom { 0 };
+    std::atomic<Job *> slots[JOB_QUEUE_SIZE];
+
+    // Jobs submitted by this thread, reused round robin
+    Job jobs[JOB_QUEUE_SIZE];
+    uint64_t next_job = 0;
+    uint32_t random;
+
+    Queue(uint32_t seed) : random(seed | 1)
+    {
+        for (Job &job : this->jobs)
+            job.in_use.store(false, std::memory_order_relaxed);
+    }
+
+    // Owner only
+    bool
+    push(Job *job)
+    {
+        int64_t b = this->bottom.load(std::memory_order_relaxed);
+        int64_t t = this->top.load(std::memory_order_acquire);
+        if (b - t >= JOB_QUEUE_SIZE)
+            return false;
+
+        this->slots[b & (JOB_QUEUE_SIZE - 1)].store(job, std::memory_order_relaxed);
+        this->bottom.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Owner only, newest first
+    Job *
+    pop()
+    {
+        int64_t b = this->bottom.load(std::memory_order_relaxed) - 1;
+        this->bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = this->top.load(std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            this->bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Job *job = this->slots[b & (JOB_QUEUE_SIZE - 1)].load(std::memory_order_relaxed);
+        if (t == b)
+        {
+            // Last job, race the thieves for it
+            if (!this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed))
+                job = nullptr;
+            this->bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    // Any thread, oldest first
+    Job *
+    steal()
+    {
+        int64_t t = this->top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = this->bottom.load(std::memory_order_acquire);
+        if (t >= b)
+            return nullptr;
+
+        Job *job = this->slots[t & (JOB_QUEUE_SIZE - 1)].load(std::memory_order_relaxed);
+        if (!this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                               std::memory_order_relaxed))
+            return nullptr;
+        return job;
+    }
+};
+
+static thread_local JobPool *current_pool = nullptr;
+static thread_local void *current_queue = nullptr;
+
+static void
+wait_frame_jobs(void *pool)
+{
+    ((JobPool *) pool)->frame.wait();
+}
+
+/* Dependency counter */
+
+bool
+JobCounter::done() const
+{
+    return this->count.load(std::memory_order_acquire) == 0 &&
+           this->dependents.load(std::memory_order_acquire) == closed();
+}
+
+int
+JobCounter::pending() const
+{
+    return this->count.load(std::memory_order_relaxed);
+}
+
+/* Task group */
+
+void
+TaskGroup::wait()
+{
+    this->pool.wait(this->counter);
+}
+
+/* Job pool */
+
+JobPool::JobPool(int threads) :
+    frame(*this),
+    stopping(false),
+    epoch(0),
+    sleepers(0)
+{
+    if (threads <= 0)
+        threads = std::max(1, (int) std::thread::hardware_concurrency());
+
+    for (int i = 0; i < threads; ++i)
+        this->queues.push_back(std::make_unique<Queue>(0x9e3779b9u * uint32_t(i + 1)));
+
+    current_pool = this;
+    current_queue = this->queues[0].get();
+
+    for (int i = 1; i < threads; ++i)
+        this->workers.emplace_back(&JobPool::worker_loop, this, i);
+
+    AddFrameEndCallback(wait_frame_jobs, this);
+}
+
+JobPool::~JobPool()
+{
+    RemoveFrameEndCallback(wait_frame_jobs, this);
+    this->frame.wait();
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping.store(true);
+    }
+    this->wake_cv.notify_all();
+    for (std::thread &worker : this->workers)
+        worker.join();
+
+    if (current_pool == this)
+    {
+        current_pool = nullptr;
+        current_queue = nullptr;
+    }
+}
+
+int
+JobPool::thread_count() const
+{
+    return (int) this->queues.size();
+}
+
+JobPool::Queue *
+JobPool::this_queue()
+{
+    return current_pool == this ? (Queue *) current_queue : nullptr;
+}
+
+Job *
+JobPool::allocate_job()
+{
+    Queue *self = this_queue();
+    if (self == nullptr)
+        return nullptr;
+
+    // The ring came round to a job that is still queued, waiting on a
+    // dependency or running further up this stack; the caller runs the new
+    // one inline and tries the same slot next time
+    Job *job = &self->jobs[self->next_job & (JOB_QUEUE_SIZE - 1)];
+    if (job->in_use.load(std::memory_order_acquire))
+        return nullptr;
+
+    self->next_job++;
+    job->in_use.store(true, std::memory_order_relaxed);
+    job->next = nullptr;
+    return job;
+}
+
+void
+JobPool::arm(JobCounter &counter)
+{
+    if (counter.count.fetch_add(1, std::memory_order_acq_rel) != 0)
+        return;
+
+    // Reopen the dependents, once the job that last took the counter to
+    // zero has closed them
+    Job *expected = JobCounter::closed();
+    while (!counter.dependents.compare_exchange_weak(expected, nullptr,
+                                                     std::memory_order_acq_rel))
+    {
+        expected = JobCounter::closed();
+        JOBS_PAUSE();
+    }
+}
+
+void
+JobPool::submit(Job *job)
+{
+    Queue *self = this_queue();
+    if (self == nullptr || !self->push(job))
+    {
+        execute(job);
+        return;
+    }
+
+    this->epoch.fetch_add(1, std::memory_order_seq_cst);
+    if (this->sleepers.load(std::memory_order_seq_cst) > 0)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->wake_cv.notify_one();
+    }
+}
+
+void
+JobPool::defer(JobCounter &dependency, Job *job)
+{
+    Job *head = dependency.dependents.load(std::memory_order_acquire);
+    do
+    {
+        if (head == JobCounter::closed())
+        {
+            submit(job);
+            return;
+        }
+        job->next = head;
+    }
+    while (!dependency.dependents.compare_exchange_weak(head, job, std::memory_order_release,
+                                                        std::memory_order_acquire));
+}
+
+Job *
+JobPool::find_job(Queue &self)
+{
+    Job *job = self.pop();
+    if (job != nullptr)
+        return job;
+
+    const int count = (int) this->queues.size();
+    if (count == 1)
+        return nullptr;
+
+    // xorshift32 picks where to start stealing
+    self.random ^= self.random << 13;
+    self.random ^= self.random >> 17;
+    self.random ^= self.random << 5;
+
+    int start = int(self.random % uint32_t(count));
+    for (int i = 0; i < count; ++i)
+    {
+        Queue &victim = *this->queues[(start + i) % count];
+        if (&victim == &self)
+            continue;
+        job = victim.steal();
+        if (job != nullptr)
+            return job;
+    }
+    return nullptr;
+}
+
+void
+JobPool::execute(Job *job)
+{
+    job->function(*job);
+
+    JobCounter *counter = job->counter;
+    job->in_use.store(false, std::memory_order_release);
+
+    if (counter->count.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    // Closing is the last touch of the counter, wait() returns after it
+    Job *dependents = counter->dependents.exchange(JobCounter::closed(),
+                                                   std::memory_order_acq_rel);
+    while (dependents != nullptr)
+    {
+        Job *next = dependents->next;
+        submit(dependents);
+        dependents = next;
+    }
+}
+
+void
+JobPool::wait(JobCounter &counter)
+{
+    Queue *self = this_queue();
+    while (!counter.done())
+    {
+        Job *job = self != nullptr ? find_job(*self) : nullptr;
+        if (job != nullptr)
+            execute(job);
+        else
+            std::this_thread::yield();
+    }
+}
+
+bool
+JobPool::help()
+{
+    Queue *self = this_queue();
+    Job *job = self != nullptr ? find_job(*self) : nullptr;
+    if (job == nullptr)
+        return false;
+
+    execute(job);
+    return true;
+}
+
+void
+JobPool::worker_loop(int index)
+{
+    Queue &self = *this->queues[index];
+    current_pool = this;
+    current_queue = &self;
+
+    while (!this->stopping.load(std::memory_order_relaxed))
+    {
+        uint64_t seen = this->epoch.load(std::memory_order_seq_cst);
+
+        Job *job = nullptr;
+        for (int round = 0; round < JOBS_SPIN_ROUNDS && job == nullptr; ++round)
+        {
+            job = find_job(self);
+            if (job == nullptr)
+                JOBS_PAUSE();
+        }
+
+        if (job != nullptr)
+        {
+            execute(job);
+            continue;
+        }
+
+        // Sleep until something is submitted. A submit that saw no sleepers
+        // bumped the epoch first, so the check below catches it.
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->sleepers.fetch_add(1, std::memory_order_seq_cst);
+        this->wake_cv.wait(lock, [&] {
+            return this->stopping.load(std::memory_order_relaxed) ||
+                   this->epoch.load(std::memory_order_seq_cst) != seen;
+        });
+        this->sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
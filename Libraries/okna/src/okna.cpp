@@ -8,6 +8,8 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <raylib-ext.hpp>
+#include <raylib-ext/frame.hpp>
+#include <raylib-ext/profiler.hpp>
 
 #define DECORATION_HEIGHT 29
 
@@ -123,6 +125,7 @@ Window::sync_position()
 void
 Window::sync()
 {
+    PROFILE_SCOPE("Window::sync");
     glfwPollEvents();
     if (this->resizable) sync_size();
     sync_position();
@@ -143,6 +146,7 @@ void Clock::start()
 
 void Clock::tick()
 {
+    PROFILE_SCOPE("Clock::tick");
     uint64_t dt_end = get_ns();
     uint64_t ns_delta = dt_end - ns_count;
     std::this_thread::sleep_for(
@@ -152,6 +156,8 @@ void Clock::tick()
     dt_end = get_ns();
     dt = (dt_end - ns_count) / float(1e9);
     ns_count = dt_end;
+
+    EndFrame();
 }
 
 uint64_t Clock::get_ns()
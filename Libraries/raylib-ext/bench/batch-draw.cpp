@@ -0,0 +1,105 @@
+#include <raylib-ext.hpp>
+#include <raylib-ext/batch-draw.hpp>
+#include <raylib-ext/bench.hpp>
+
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+static double
+time_frames(int frames, const std::function<void()> &draw)
+{
+    // Warm up buffers and driver state before measuring
+    BeginDrawing();
+    ClearBackground(BLACK);
+    draw();
+    EndDrawing();
+
+    double start = BenchNowMs();
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        BeginDrawing();
+        ClearBackground(BLACK);
+        draw();
+        EndDrawing();
+    }
+    return (BenchNowMs() - start) / frames;
+}
+
+static void
+report(const char *name, int count, double immediate, double batched)
+{
+    std::printf("%-8s %8d   immediate %9.2f ms   batched %8.2f ms   %6.1fx\n",
+                name, count, immediate, batched, immediate / batched);
+}
+
+int main()
+{
+    const int width = 1280;
+    const int height = 720;
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(width, height, "bench-batch-draw");
+
+    for (int count : { 1000, 100000, 1000000 })
+    {
+        int frames = count >= 1000000 ? 3 : count >= 100000 ? 10 : 100;
+
+        std::vector<Vector2> points(count * 2);
+        std::vector<Vector2> centers(count);
+        std::vector<float> radii(count);
+        std::vector<Rectangle> rects(count);
+        std::vector<Color> colors(count);
+
+        SetRandomSeed(1234);
+        for (int i = 0; i < count; ++i)
+        {
+            points[i * 2] = { float(GetRandomValue(0, width)), float(GetRandomValue(0, height)) };
+            points[i * 2 + 1] = { float(GetRandomValue(0, width)), float(GetRandomValue(0, height)) };
+            centers[i] = points[i * 2];
+            radii[i] = float(GetRandomValue(1, 8));
+            rects[i] = { centers[i].x, centers[i].y, radii[i] * 2, radii[i] };
+            colors[i] = ColorFromHSV(float(i % 360), 1, 1);
+        }
+
+        report("lines", count,
+            time_frames(frames, [&] {
+                for (int i = 0; i < count; ++i)
+                    DrawLineV(points[i * 2], points[i * 2 + 1], colors[i]);
+            }),
+            time_frames(frames, [&] {
+                DrawLines(points.data(), colors.data(), count * 2);
+            }));
+
+        report("circles", count,
+            time_frames(frames, [&] {
+                for (int i = 0; i < count; ++i)
+                    DrawCircleV(centers[i], radii[i], colors[i]);
+            }),
+            time_frames(frames, [&] {
+                DrawCircles(centers.data(), radii.data(), colors.data(), count);
+            }));
+
+        report("rects", count,
+            time_frames(frames, [&] {
+                for (int i = 0; i < count; ++i)
+                    DrawRectangleRec(rects[i], colors[i]);
+            }),
+            time_frames(frames, [&] {
+                DrawRects(rects.data(), colors.data(), count);
+            }));
+
+        report("points", count,
+            time_frames(frames, [&] {
+                for (int i = 0; i < count; ++i)
+                    DrawRectangleV(centers[i] - Vector2 { 1, 1 }, { 2, 2 }, WHITE);
+            }),
+            time_frames(frames, [&] {
+                DrawPoints(centers.data(), count, 2, WHITE);
+            }));
+    }
+
+    CloseWindow();
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <raylib-ext.hpp>
+#include <raylib-ext/chords.hpp>
+#include <raylib-ext/bench.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <functional>
+
+static double
+time_frames(int frames, const std::function<void()> &draw)
+{
+    BeginDrawing();
+    ClearBackground(BLACK);
+    draw();
+    EndDrawing();
+
+    double start = BenchNowMs();
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        BeginDrawing();
+        ClearBackground(BLACK);
+        draw();
+        EndDrawing();
+    }
+    return (BenchNowMs() - start) / frames;
+}
+
+// Chords added up with a faint color, so the image is a density map the
+// two paths should agree on up to rasterization
+static Image
+render_density(int size, int count, float multiple, bool fallback)
+{
+    RenderTexture2D target = LoadRenderTexture(size, size);
+
+    SetModularChordsFallback(fallback);
+    BeginTextureMode(target);
+    ClearBackground(BLACK);
+    BeginBlendMode(BLEND_ADDITIVE);
+    DrawModularChords({ size / 2.0f, size / 2.0f }, size / 2.0f - 2.0f, count, multiple,
+                      Color { 255, 255, 255, 4 });
+    EndBlendMode();
+    EndTextureMode();
+    SetModularChordsFallback(false);
+
+    Image image = LoadImageFromTexture(target.texture);
+    UnloadRenderTexture(target);
+    return image;
+}
+
+// Mean difference of the two density maps, relative to their mean value
+static double
+density_difference(Image a, Image b)
+{
+    Color *pa = LoadImageColors(a);
+    Color *pb = LoadImageColors(b);
+
+    double difference = 0.0, total = 0.0;
+    for (int i = 0; i < a.width * a.height; ++i)
+    {
+        difference += std::abs(int(pa[i].r) - int(pb[i].r));
+        total += pa[i].r + pb[i].r;
+    }
+
+    UnloadImageColors(pa);
+    UnloadImageColors(pb);
+    return total > 0.0 ? 2.0 * difference / total : 0.0;
+}
+
+int main()
+{
+    const int width = 1280;
+    const int height = 720;
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(width, height, "bench-chords");
+
+    std::printf("chords on the %s\n", IsModularChordsGpu() ? "GPU" : "CPU");
+
+    for (int count : { 10000, 100000, 1000000 })
+    {
+        const int frames = count >= 1000000 ? 5 : 30;
+        const Vector2 center = { width / 2.0f, height / 2.0f };
+        const float radius = height / 2.0f - 10.0f;
+
+        double gpu = time_frames(frames, [&] {
+            DrawModularChords(center, radius, count, 2.0f, Fade(WHITE, 0.1f));
+        });
+
+        SetModularChordsFallback(true);
+        double cpu = time_frames(frames, [&] {
+            DrawModularChords(center, radius, count, 2.0f, Fade(WHITE, 0.1f));
+        });
+        SetModularChordsFallback(false);
+
+        std::printf("%7d chords   shader %8.2f ms   CPU %8.2f ms (%5.1fx)\n",
+                    count, gpu, cpu, cpu / gpu);
+    }
+
+    // Past 65536 chords n*floor(multiple) no longer fits in 32 bits, the
+    // shader has to agree with the CPU path, which does the math in 64
+    int failed = 0;
+    if (IsModularChordsGpu())
+    {
+        for (int count : { 70001, 1000003 })
+        {
+            for (float multiple : { 2.0f, 51.0f, 1234.5f })
+            {
+                Image gpu = render_density(1024, count, multiple, false);
+                Image cpu = render_density(1024, count, multiple, true);
+                double difference = density_difference(gpu, cpu);
+                UnloadImage(gpu);
+                UnloadImage(cpu);
+
+                bool same = difference < 0.05;
+                failed += !same;
+                std::printf("%7d chords x %7.1f   shader and CPU differ by %5.2f%%   %s\n",
+                            count, multiple, difference * 100.0, same ? "ok" : "MISMATCH");
+            }
+        }
+    }
+
+    CloseWindow();
+    return failed ? 1 : 0;
+}
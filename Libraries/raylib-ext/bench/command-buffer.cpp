@@ -0,0 +1,99 @@
+#include <raylib-ext.hpp>
+#include <raylib-ext/command-buffer.hpp>
+#include <raylib-ext/bench.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// One chunk of a procedural scene: curves, circles, rings and a text line
+static void
+record_chunk(CommandBuffer &buffer, int chunk, Font font)
+{
+    const int shapes = 2000;
+    buffer.reset();
+
+    for (int i = 0; i < shapes; ++i)
+    {
+        float t = float(chunk * shapes + i);
+        Vector2 a = { 640 + 600 * std::sin(t * 0.37f), 360 + 340 * std::cos(t * 0.21f) };
+        Vector2 b = { 640 + 600 * std::cos(t * 0.13f), 360 + 340 * std::sin(t * 0.29f) };
+        Color color = ColorFromHSV(std::fmod(t, 360.0f), 0.8f, 1.0f);
+
+        buffer.bezier(a, { a.x, b.y }, { b.x, a.y }, b, 1.5f, color, 16);
+        buffer.circle(a, 3.0f + i % 5, color, 24);
+        buffer.ring(b, 4.0f, 6.0f, color, 24);
+    }
+
+    // TextFormat() is not thread safe
+    char label[32];
+    std::snprintf(label, sizeof(label), "chunk %d", chunk);
+    buffer.text(font, label, { 10.0f, 10.0f + chunk * 12.0f }, 10.0f, 1.0f, WHITE);
+}
+
+int main()
+{
+    const int chunks = 64;
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(1280, 720, "bench-command-buffer");
+
+    Font font = GetFontDefault();
+    std::vector<CommandBuffer> buffers(chunks);
+
+    // Grow every buffer once so the first run doesn't pay for allocation
+    for (int chunk = 0; chunk < chunks; ++chunk)
+        record_chunk(buffers[chunk], chunk, font);
+
+    double single = 0.0;
+
+    for (int threads : BenchThreadCounts())
+    {
+        const int frames = 10;
+        double record = 0.0, submit = 0.0;
+
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            double start = BenchNowMs();
+
+            // Static chunk assignment keeps every run recording the same data
+            std::vector<std::thread> workers;
+            for (int worker = 0; worker < threads; ++worker)
+            {
+                workers.emplace_back([&, worker] {
+                    for (int chunk = worker; chunk < chunks; chunk += threads)
+                        record_chunk(buffers[chunk], chunk, font);
+                });
+            }
+            for (std::thread &worker : workers)
+                worker.join();
+
+            double recorded = BenchNowMs();
+
+            BeginDrawing();
+            ClearBackground(BLACK);
+            SubmitCommandBuffers(buffers.data(), chunks);
+            EndDrawing();
+
+            record += recorded - start;
+            submit += BenchNowMs() - recorded;
+        }
+
+        record /= frames;
+        submit /= frames;
+        if (threads == 1)
+            single = record;
+
+        int vertices = 0;
+        for (const CommandBuffer &buffer : buffers)
+            vertices += buffer.vertex_count();
+
+        std::printf("threads %2d   record %8.2f ms (%4.1fx)   submit %7.2f ms   %d vertices\n",
+                    threads, record, single / record, submit, vertices);
+    }
+
+    CloseWindow();
+    return 0;
+}
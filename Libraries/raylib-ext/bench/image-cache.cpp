@@ -0,0 +1,64 @@
+#include <raylib-ext.hpp>
+#include <raylib-ext/image-cache.hpp>
+#include <raylib-ext/bench.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+const int GENERATED_COUNT = 24;
+const int GENERATED_SIZE = 1024;
+
+template <typename F>
+static double
+measure(const std::vector<std::string> &files, F load)
+{
+    double start = BenchNowMs();
+    for (const std::string &file : files)
+    {
+        Image image = load(file);
+        UnloadImage(image);
+    }
+    return BenchNowMs() - start;
+}
+
+int main(int argc, char **argv)
+{
+    SetTraceLogLevel(LOG_WARNING);
+
+    std::string dir = argc > 1 ? argv[1] : "image-cache-bench";
+    if (!DirectoryExists(dir))
+    {
+        std::printf("Generating %d %dx%d textures in %s/\n",
+                    GENERATED_COUNT, GENERATED_SIZE, GENERATED_SIZE, dir.c_str());
+        std::filesystem::create_directories(dir);
+        for (int i = 0; i < GENERATED_COUNT; ++i)
+        {
+            Image image = GenImageCellular(GENERATED_SIZE, GENERATED_SIZE,
+                                           32 + i);
+            ExportImage(image, dir + "/noise-" + std::to_string(i) + ".png");
+            UnloadImage(image);
+        }
+    }
+
+    std::vector<std::string> files;
+    FilePathList list = LoadDirectoryFilesEx(dir.c_str(), ".png;.jpg;.jpeg;.bmp;.tga", true);
+    for (unsigned int i = 0; i < list.count; ++i)
+        files.push_back(list.paths[i]);
+    UnloadDirectoryFiles(list);
+
+    for (const std::string &file : files)
+        DeleteImageCache(file);
+
+    double decode = measure(files, [](const std::string &f) { return LoadImage(f); });
+    double populate = measure(files, [](const std::string &f) { return LoadImageCached(f); });
+    double warm = measure(files, [](const std::string &f) { return LoadImageCached(f); });
+
+    std::printf("%zu images\n", files.size());
+    std::printf("cold (LoadImage):          %10.2f ms\n", decode);
+    std::printf("miss (decode + write):     %10.2f ms\n", populate);
+    std::printf("warm (LoadImageCached):    %10.2f ms  (%.1fx)\n", warm, decode / warm);
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <raylib-ext.hpp>
+#include <raylib-ext/image-export.hpp>
+#include <raylib-ext/bench.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+
+static Image
+generate_poster(int size)
+{
+    Image image = GenImageColor(size, size, BLACK);
+    Color *pixels = (Color *) image.data;
+    for (int y = 0; y < size; ++y)
+    {
+        for (int x = 0; x < size; ++x)
+        {
+            float u = float(x) / size, v = float(y) / size;
+            float hue = std::fmod(360.0f * (u + v) + 40.0f * std::sin(20.0f * u), 360.0f);
+            Color c = ColorFromHSV(hue, 0.8f, 0.5f + 0.5f * std::sin(31.0f * v * u));
+            if (((x / 64) + (y / 64)) % 7 == 0)
+                c = WHITE;
+            pixels[y * size + x] = c;
+        }
+    }
+    return image;
+}
+
+static bool
+matches(Image image, const std::string &fileName)
+{
+    if (IsFileExtension(fileName, ".ppm"))
+        return true;    // raylib has no PPM loader
+
+    Image loaded = LoadImage(fileName);
+    ImageFormat(&loaded, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    bool same = loaded.width == image.width && loaded.height == image.height
+        && std::memcmp(loaded.data, image.data, size_t(image.width) * image.height * 4) == 0;
+    UnloadImage(loaded);
+    return same;
+}
+
+int main(int argc, char **argv)
+{
+    SetTraceLogLevel(LOG_WARNING);
+
+    int size = argc > 1 ? std::atoi(argv[1]) : 4096;
+    int max_threads = std::max(1, int(std::thread::hardware_concurrency()));
+    Image image = generate_poster(size);
+    std::printf("%dx%d RGBA, %d hardware threads\n", size, size, max_threads);
+
+    double start = BenchNowMs();
+    ExportImage(image, "export-bench-reference.png");
+    double reference = BenchNowMs() - start;
+    std::printf("ExportImage png                   %10.1f ms  %8d KiB\n", reference,
+                GetFileLength("export-bench-reference.png") / 1024);
+
+    for (const char *ext : { ".png", ".qoi", ".ppm" })
+    {
+        std::string fileName = std::string("export-bench") + ext;
+        double single = 0.0;
+        for (int threads : BenchThreadCounts(max_threads))
+        {
+            start = BenchNowMs();
+            ExportImageParallel(image, fileName, threads);
+            double elapsed = BenchNowMs() - start;
+            if (threads == 1)
+                single = elapsed;
+
+            // Against ExportImage(), then against one thread of the same format
+            std::printf("ExportImageParallel %s %2d threads %10.1f ms  %8d KiB  %.2fx  %4.1fx/1%s\n",
+                        ext, threads, elapsed, GetFileLength(fileName.c_str()) / 1024,
+                        reference / elapsed, single / elapsed,
+                        matches(image, fileName) ? "" : "  MISMATCH");
+        }
+        std::remove(fileName.c_str());
+    }
+    std::remove("export-bench-reference.png");
+
+    UnloadImage(image);
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include <raylib-ext.hpp>
+#include <raylib-ext/batch-draw.hpp>
+#include <raylib-ext/instancing.hpp>
+#include <raylib-ext/bench.hpp>
+
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+static double
+time_frames(int frames, const std::function<void()> &draw)
+{
+    BeginDrawing();
+    ClearBackground(BLACK);
+    draw();
+    EndDrawing();
+
+    double start = BenchNowMs();
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        BeginDrawing();
+        ClearBackground(BLACK);
+        draw();
+        EndDrawing();
+    }
+    return (BenchNowMs() - start) / frames;
+}
+
+int main()
+{
+    const int width = 1280;
+    const int height = 720;
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(width, height, "bench-instancing");
+
+    std::printf("instancing %s\n", IsInstancingSupported() ? "supported" : "not supported");
+
+    for (int count : { 1000, 10000, 100000 })
+    {
+        const int frames = count >= 100000 ? 5 : 30;
+
+        std::vector<ShapeInstance> instances(count);
+        std::vector<Vector2> centers(count);
+        std::vector<float> radii(count);
+        std::vector<Color> colors(count);
+
+        SetRandomSeed(7);
+        for (int i = 0; i < count; ++i)
+        {
+            float radius = float(GetRandomValue(2, 6));
+            Color color = ColorFromHSV(float(i % 360), 0.8f, 1.0f);
+            Vector2 center = { float(GetRandomValue(0, width)), float(GetRandomValue(0, height)) };
+
+            instances[i] = { center, { radius, radius }, 0.0f, color };
+            centers[i] = center;
+            radii[i] = radius;
+            colors[i] = color;
+        }
+
+        double immediate = time_frames(frames, [&] {
+            for (int i = 0; i < count; ++i)
+                DrawCircleV(centers[i], radii[i], colors[i]);
+        });
+
+        double batched = time_frames(frames, [&] {
+            DrawCircles(centers.data(), radii.data(), colors.data(), count);
+        });
+
+        double instanced = time_frames(frames, [&] {
+            DrawCirclesInstanced(instances.data(), count);
+        });
+
+        SetInstancingFallback(true);
+        double fallback = time_frames(frames, [&] {
+            DrawCirclesInstanced(instances.data(), count);
+        });
+        SetInstancingFallback(false);
+
+        std::printf("%6d circles   DrawCircleV %8.2f ms   DrawCircles %7.2f ms"
+                    "   instanced %6.2f ms (%5.1fx)   fallback %7.2f ms\n",
+                    count, immediate, batched, instanced, immediate / instanced, fallback);
+    }
+
+    CloseWindow();
+    return 0;
+}
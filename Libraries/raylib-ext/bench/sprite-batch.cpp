@@ -0,0 +1,98 @@
+#include <raylib-ext.hpp>
+#include <raylib-ext/render-stats.hpp>
+#include <raylib-ext/sprite-batch.hpp>
+#include <raylib-ext/bench.hpp>
+
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+static double
+time_frames(int frames, const std::function<void()> &draw, RenderStats &stats)
+{
+    double start = BenchNowMs();
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        BeginDrawing();
+        ClearBackground(BLACK);
+        draw();
+        EndDrawing();
+        UpdateRenderStats();
+    }
+    stats = GetRenderStats();
+    return (BenchNowMs() - start) / frames;
+}
+
+int main()
+{
+    const int width = 1280;
+    const int height = 720;
+    const int texture_count = 8;
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(width, height, "bench-sprite-batch");
+    EnableRenderStats();
+
+    std::vector<Texture2D> textures;
+    for (int i = 0; i < texture_count; ++i)
+    {
+        Color color = ColorFromHSV(360.0f * i / texture_count, 0.7f, 1.0f);
+        Image image = GenImageChecked(16, 16, 4, 4, color, BLANK);
+        textures.push_back(LoadTextureFromImage(image));
+        UnloadImage(image);
+    }
+
+    SpriteBatch batch;
+
+    for (int count : { 1000, 10000, 100000 })
+    {
+        struct Placed { int texture; Vector2 position; float rotation; };
+        std::vector<Placed> placed(count);
+
+        // Worst case for rlgl: every sprite changes texture
+        SetRandomSeed(42);
+        for (int i = 0; i < count; ++i)
+        {
+            placed[i].texture = i % texture_count;
+            placed[i].position = { float(GetRandomValue(0, width)), float(GetRandomValue(0, height)) };
+            placed[i].rotation = float(GetRandomValue(0, 359));
+        }
+
+        const int frames = count >= 100000 ? 5 : 30;
+        RenderStats immediate_stats, batched_stats;
+
+        double immediate = time_frames(frames, [&] {
+            for (const Placed &p : placed)
+            {
+                Texture2D texture = textures[p.texture];
+                DrawTexturePro(texture, { 0, 0, 16, 16 }, { p.position.x, p.position.y, 16, 16 },
+                               { 8, 8 }, p.rotation, WHITE);
+            }
+        }, immediate_stats);
+
+        double batched = time_frames(frames, [&] {
+            batch.begin();
+            for (const Placed &p : placed)
+            {
+                Texture2D texture = textures[p.texture];
+                batch.draw(texture, { 0, 0, 16, 16 }, { p.position.x, p.position.y, 16, 16 },
+                           { 8, 8 }, p.rotation, WHITE);
+            }
+            batch.end();
+        }, batched_stats);
+
+        SpriteBatchStats stats = batch.stats();
+        std::printf("%6d sprites  immediate %8.2f ms, %6d draws, %4d flushes"
+                    "   batched %7.2f ms, %3d draws (%d unsorted)\n",
+                    count, immediate, immediate_stats.draw_calls, immediate_stats.flushes,
+                    batched, batched_stats.draw_calls, stats.draw_calls_unsorted);
+    }
+
+    for (Texture2D texture : textures)
+        UnloadTexture(texture);
+
+    DisableRenderStats();
+    CloseWindow();
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include <raylib-ext.hpp>
+#include <raylib-ext/tessellation.hpp>
+#include <raylib-ext/bench.hpp>
+
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+static double
+time_frames(int frames, const std::function<void()> &draw)
+{
+    BeginDrawing();
+    ClearBackground(BLACK);
+    draw();
+    EndDrawing();
+
+    double start = BenchNowMs();
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        BeginDrawing();
+        ClearBackground(BLACK);
+        draw();
+        EndDrawing();
+    }
+    return (BenchNowMs() - start) / frames;
+}
+
+int main()
+{
+    const int width = 1280;
+    const int height = 720;
+    const int count = 5000;
+    const int frames = 30;
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(width, height, "bench-tessellation");
+
+    std::vector<Vector2> centers(count);
+    std::vector<float> radii(count);
+    SetRandomSeed(3);
+    for (int i = 0; i < count; ++i)
+    {
+        centers[i] = { float(GetRandomValue(0, width)), float(GetRandomValue(0, height)) };
+        radii[i] = float(GetRandomValue(2, 40));
+    }
+
+    double ring = time_frames(frames, [&] {
+        for (int i = 0; i < count; ++i)
+            DrawRing(centers[i], radii[i] * 0.8f, radii[i], 0, 360, 200, RED);
+    });
+    double ring_cached = time_frames(frames, [&] {
+        for (int i = 0; i < count; ++i)
+            DrawRingCached(centers[i], radii[i] * 0.8f, radii[i], 0, 360, 200, RED);
+    });
+    double ring_adaptive = time_frames(frames, [&] {
+        for (int i = 0; i < count; ++i)
+            DrawRingCached(centers[i], radii[i] * 0.8f, radii[i], 0, 360, 0, RED);
+    });
+
+    double circle = time_frames(frames, [&] {
+        for (int i = 0; i < count; ++i)
+            DrawCircleV(centers[i], radii[i], BLUE);
+    });
+    double circle_cached = time_frames(frames, [&] {
+        for (int i = 0; i < count; ++i)
+            DrawCircleCached(centers[i], radii[i], BLUE);
+    });
+
+    double rounded = time_frames(frames, [&] {
+        for (int i = 0; i < count; ++i)
+            DrawRectangleRounded({ centers[i].x, centers[i].y, 40, 20 }, 0.5f, 8, GREEN);
+    });
+    double rounded_cached = time_frames(frames, [&] {
+        for (int i = 0; i < count; ++i)
+            DrawRectangleRoundedCached({ centers[i].x, centers[i].y, 40, 20 }, 0.5f, 8, GREEN);
+    });
+
+    TessellationCacheStats stats = GetTessellationCacheStats();
+
+    std::printf("%d shapes per frame\n", count);
+    std::printf("ring (200 segments)  %7.2f ms   cached %7.2f ms   adaptive %7.2f ms\n",
+                ring, ring_cached, ring_adaptive);
+    std::printf("circle               %7.2f ms   cached %7.2f ms\n", circle, circle_cached);
+    std::printf("rounded rectangle    %7.2f ms   cached %7.2f ms\n", rounded, rounded_cached);
+    std::printf("cache: %d shapes, %d hits, %d misses\n", stats.shapes, stats.hits, stats.misses);
+
+    CloseWindow();
+    return 0;
+}
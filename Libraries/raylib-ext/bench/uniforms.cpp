@@ -0,0 +1,120 @@
+#include <raylib-ext.hpp>
+#include <raylib-ext/uniforms.hpp>
+#include <raylib-ext/bench.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <functional>
+
+// Tinted rings; every quad is drawn with its own tint, the other uniforms
+// change once a frame or never
+static const char *rings_fs = R"(#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+out vec4 finalColor;
+uniform float time;
+uniform vec2 resolution;
+uniform float rings;
+uniform vec4 tint;
+void main()
+{
+    float d = length(gl_FragCoord.xy/resolution - vec2(0.5));
+    float ring = 0.5 + 0.5*sin(d*rings - time*4.0);
+    finalColor = vec4(tint.rgb*ring, 1.0)*fragColor;
+}
+)";
+
+static double
+time_frames(int frames, const std::function<void(int frame)> &draw)
+{
+    BeginDrawing();
+    ClearBackground(BLACK);
+    draw(0);
+    EndDrawing();
+
+    double start = BenchNowMs();
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        BeginDrawing();
+        ClearBackground(BLACK);
+        draw(frame);
+        EndDrawing();
+    }
+    return (BenchNowMs() - start) / frames;
+}
+
+int main()
+{
+    const int width = 1280;
+    const int height = 720;
+    const int quads = 400;
+    const int frames = 60;
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(width, height, "bench-uniforms");
+
+    Shader shader = LoadShaderFromMemory(nullptr, rings_fs);
+    const Vector2 resolution = { float(width), float(height) };
+    const float rings = 60.0f;
+
+    auto quad_rect = [&](int i) {
+        return Rectangle { float(i % 20) * 64, float(i / 20) * 36, 60, 32 };
+    };
+    auto quad_tint = [](int i) {
+        Color color = ColorFromHSV(float(i * 7 % 360), 0.7f, 1.0f);
+        return Vector4 { color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, 1.0f };
+    };
+
+    // Looks every location up and sets every value again for each quad
+    double direct = time_frames(frames, [&](int frame) {
+        float time = frame / 60.0f;
+        BeginShaderMode(shader);
+        for (int i = 0; i < quads; ++i)
+        {
+            Vector4 tint = quad_tint(i);
+            rlDrawRenderBatchActive();
+            SetShaderValue(shader, GetShaderLocation(shader, "time"), &time, SHADER_UNIFORM_FLOAT);
+            SetShaderValue(shader, GetShaderLocation(shader, "resolution"), &resolution, SHADER_UNIFORM_VEC2);
+            SetShaderValue(shader, GetShaderLocation(shader, "rings"), &rings, SHADER_UNIFORM_FLOAT);
+            SetShaderValue(shader, GetShaderLocation(shader, "tint"), &tint, SHADER_UNIFORM_VEC4);
+            DrawRectangleRec(quad_rect(i), WHITE);
+        }
+        EndShaderMode();
+    });
+
+    // Same values through the table, which only uploads the tint and, once
+    // a frame, the time
+    ShaderUniforms uniforms(shader);
+    const int time_slot = uniforms.add("time", SHADER_UNIFORM_FLOAT);
+    const int resolution_slot = uniforms.add("resolution", SHADER_UNIFORM_VEC2);
+    const int rings_slot = uniforms.add("rings", SHADER_UNIFORM_FLOAT);
+    const int tint_slot = uniforms.add("tint", SHADER_UNIFORM_VEC4);
+
+    double table = time_frames(frames, [&](int frame) {
+        float time = frame / 60.0f;
+        BeginShaderMode(shader);
+        for (int i = 0; i < quads; ++i)
+        {
+            rlDrawRenderBatchActive();
+            uniforms.set(time_slot, time);
+            uniforms.set(resolution_slot, resolution);
+            uniforms.set(rings_slot, rings);
+            uniforms.set(tint_slot, quad_tint(i));
+            uniforms.apply();
+            DrawRectangleRec(quad_rect(i), WHITE);
+        }
+        EndShaderMode();
+    });
+
+    UniformStats stats = GetUniformStats();
+    std::printf("%d quads x 4 uniforms   SetShaderValue %7.2f ms   ShaderUniforms %7.2f ms (%4.1fx)\n",
+                quads, direct, table, direct / table);
+    std::printf("last frame: %d sets, %d unchanged, %d uploads, %d applies, %d GL calls, %d saved\n",
+                stats.sets, stats.unchanged, stats.uploads, stats.applies,
+                stats.gl_calls, stats.gl_calls_saved);
+
+    UnloadShader(shader);
+    CloseWindow();
+    return 0;
+}
@@ -270,4 +270,15 @@ Music
 LoadMusicStreamFromMemory(const std::string &fileType, unsigned char *data,
                           int dataSize);
 
+/* Frame boundaries, see raylib-ext/frame.hpp */
+
+void
+FrameBeginDrawing();
+
+void
+FrameEndDrawing();
+
+#define BeginDrawing() FrameBeginDrawing()
+#define EndDrawing() FrameEndDrawing()
+
 #endif // RAYLIB_EXT_HPP
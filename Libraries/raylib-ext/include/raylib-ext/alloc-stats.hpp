@@ -0,0 +1,62 @@
+#ifndef RAYLIB_EXT_ALLOC_STATS_HPP
+#define RAYLIB_EXT_ALLOC_STATS_HPP
+
+#include <cstdint>
+#include <raylib-ext.hpp>
+
+/* Allocation stats */
+
+// Counts heap allocations per frame, on all threads. Built with
+// -DRAYLIB_EXT_ALLOC_STATS=ON only: raylib-ext then replaces the global
+// operator new and delete (the plain, array, sized and nothrow forms; not
+// the over-aligned ones). Without it every counter stays at zero. raylib's
+// own C allocations (MemAlloc, RL_MALLOC) are not seen.
+//
+// Frames end at EndDrawing() or Clock::tick(), see raylib-ext/frame.hpp.
+//
+// Code between BeginNoAlloc() and EndNoAlloc() is expected not to allocate.
+// Allocations made there are counted as violations and logged once. With
+// SetNoAllocStackTraces(true) the stack of every distinct allocating call
+// site is printed instead, to stderr (glibc and macOS only).
+
+struct AllocStats
+{
+    uint64_t allocations;       // operator new calls
+    uint64_t frees;             // operator delete calls
+    uint64_t bytes;             // bytes requested
+    uint64_t peak_bytes;        // most bytes live at once during the frame
+    uint64_t live_bytes;        // bytes live at the end of the frame
+    uint64_t violations;        // allocations inside no-alloc regions
+};
+
+// False when raylib-ext was built without RAYLIB_EXT_ALLOC_STATS
+bool
+IsAllocStatsAvailable();
+
+// Closes the frame's counters. EndFrame() calls it.
+void
+UpdateAllocStats();
+
+// Counters of the last completed frame
+AllocStats
+GetAllocStats();
+
+// Counters of the frame in progress
+AllocStats
+GetFrameAllocStats();
+
+// Regions nest and are per thread; name must outlive the region
+void
+BeginNoAlloc(const char *name);
+
+void
+EndNoAlloc();
+
+void
+SetNoAllocStackTraces(bool enabled);
+
+// Draws the last frame's counters as a small text panel
+void
+DrawAllocStats(int x, int y);
+
+#endif // RAYLIB_EXT_ALLOC_STATS_HPP
@@ -0,0 +1,82 @@
+#ifndef RAYLIB_EXT_ATLAS_HPP
+#define RAYLIB_EXT_ATLAS_HPP
+
+#include <string>
+#include <vector>
+#include <raylib-ext.hpp>
+#include <raylib-ext/sprite-batch.hpp>
+
+/* Runtime texture atlas */
+
+struct AtlasRegion
+{
+    int page;
+    Rectangle source;   // pixels of the page texture, padding excluded
+};
+
+// Packs images into one or more square RGBA8 pages with a skyline
+// bottom-left packer, so sprites from many small images share a texture
+// and batch together. Every image is surrounded by `padding` pixels that
+// repeat its edges, which keeps bilinear filtering from bleeding in
+// neighbours. With mipmaps, regions are also aligned to 4 pixels.
+//
+// Images can be added at any time; a new page is opened when none has
+// room. Pixels go to the GPU on upload(), which the draw helpers call.
+// Create and use the atlas on the GL thread, after InitWindow().
+struct TextureAtlas
+{
+    explicit TextureAtlas(int pageSize = 1024, int padding = 2, bool mipmaps = false);
+    TextureAtlas(const TextureAtlas &) = delete;
+    TextureAtlas& operator=(const TextureAtlas &) = delete;
+    ~TextureAtlas();
+
+    // Region ids, -1 if the image doesn't fit in an empty page
+    int add(Image image);
+    int add(const std::string &fileName);
+
+    void upload();
+
+    AtlasRegion region(int id) const { return this->regions[id]; }
+    Texture2D texture(int page) const { return this->pages[page].texture; }
+    int region_count() const { return (int) this->regions.size(); }
+    int page_count() const { return (int) this->pages.size(); }
+
+    // Fraction of the page area covered by regions, padding included
+    float occupancy(int page) const;
+
+    void draw(int id, Vector2 position, Color tint);
+    void draw(int id, Rectangle dest, Vector2 origin, float rotation, Color tint);
+    void draw(SpriteBatch &batch, int id, Rectangle dest, Vector2 origin, float rotation,
+              Color tint, int layer = 0, float depth = 0.0f);
+
+private:
+    struct SkylineNode
+    {
+        int x;
+        int y;
+        int width;
+    };
+
+    struct Page
+    {
+        Image image;
+        Texture2D texture;
+        std::vector<SkylineNode> skyline;
+        std::vector<Rectangle> dirty;
+        long long used_area;
+    };
+
+    int page_size;
+    int padding;
+    int alignment;
+    bool mipmaps;
+    std::vector<Page> pages;
+    std::vector<AtlasRegion> regions;
+
+    bool fits(const Page &page, int index, int width, int height, int &y) const;
+    bool pack(Page &page, int width, int height, int &x, int &y);
+    Page &add_page();
+    void blit(Page &page, Image image, int x, int y);
+};
+
+#endif // RAYLIB_EXT_ATLAS_HPP
@@ -0,0 +1,41 @@
+#ifndef RAYLIB_EXT_BATCH_DRAW_HPP
+#define RAYLIB_EXT_BATCH_DRAW_HPP
+
+#include <raylib-ext.hpp>
+
+/* Batched array drawing */
+
+// Array counterparts of DrawLineV(), DrawPixelV(), DrawCircleV() and
+// DrawRectangleRec(). Every call tessellates on the CPU into one vertex
+// array and submits it with a single draw, skipping the per-vertex rlgl
+// immediate mode path. Anything drawn before the call is flushed first so
+// layering stays the same. Drawing always uses the default shader.
+//
+// Per-primitive color arrays may be nullptr, in which case WHITE is used.
+
+// Line segments points[0]->points[1], points[2]->points[3], ...
+void
+DrawLines(const Vector2 *points, int pointCount, Color color);
+
+void
+DrawLines(const Vector2 *points, const Color *colors, int pointCount);
+
+// Square points of the given size, centered on each position
+void
+DrawPoints(const Vector2 *points, int count, float size, Color color);
+
+void
+DrawCircles(const Vector2 *centers, const float *radii, int count, Color color,
+            int segments = 36);
+
+void
+DrawCircles(const Vector2 *centers, const float *radii, const Color *colors,
+            int count, int segments = 36);
+
+void
+DrawRects(const Rectangle *rects, int count, Color color);
+
+void
+DrawRects(const Rectangle *rects, const Color *colors, int count);
+
+#endif // RAYLIB_EXT_BATCH_DRAW_HPP
@@ -0,0 +1,21 @@
+#ifndef RAYLIB_EXT_BENCH_HPP
+#define RAYLIB_EXT_BENCH_HPP
+
+#include <vector>
+
+/* Benchmark helpers */
+
+// Shared by the bench-* programs of raylib-ext and the libraries built on
+// it.
+
+// Steady clock in milliseconds, for differences only
+double
+BenchNowMs();
+
+// Thread counts to time a pool with: the powers of two below max_threads,
+// then max_threads itself (1, 2, 4, 6 for 6). max_threads < 1 means
+// std::thread::hardware_concurrency().
+std::vector<int>
+BenchThreadCounts(int max_threads = 0);
+
+#endif // RAYLIB_EXT_BENCH_HPP
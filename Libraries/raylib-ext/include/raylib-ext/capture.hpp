@@ -0,0 +1,100 @@
+#ifndef RAYLIB_EXT_CAPTURE_HPP
+#define RAYLIB_EXT_CAPTURE_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <raylib-ext.hpp>
+
+struct __GLsync;
+
+/* Frame capture */
+
+enum CaptureFormat
+{
+    CAPTURE_PNG,
+    CAPTURE_QOI,
+    CAPTURE_RAW,    // RGBA8, top row first, no header
+};
+
+struct CaptureStats
+{
+    uint64_t captured;  // frames read back from the GPU
+    uint64_t written;   // frames encoded and written to disk
+    uint64_t dropped;   // frames discarded because the encode queue was full
+    uint64_t stalls;    // grabs that waited for a readback still in flight
+    uint64_t blocked;   // grabs that waited for the encoders to catch up
+    int queued;         // frames waiting to be encoded
+    int capacity;       // encode queue capacity
+};
+
+// Records the default framebuffer into a numbered image sequence without
+// stalling the frame: pixels are read back asynchronously into a ring of
+// pixel-pack buffers and encoded by a pool of worker threads.
+//
+// Call grab() after drawing and before EndDrawing(). The capture must be
+// destroyed (or finish()ed) while the GL context is still alive.
+struct FrameCapture
+{
+    std::string directory;
+    std::string prefix;
+    CaptureFormat format;
+    bool drop_when_full;
+
+    FrameCapture(const std::string &directory,
+                 CaptureFormat format = CAPTURE_PNG,
+                 int readback_buffers = 3, int workers = 0,
+                 int max_queued = 0, bool drop_when_full = false);
+    FrameCapture(const FrameCapture &) = delete;
+    FrameCapture& operator=(const FrameCapture &) = delete;
+    ~FrameCapture();
+
+    void grab();
+    void finish();
+    CaptureStats stats();
+    bool backpressure();
+
+private:
+    struct Readback
+    {
+        unsigned int pbo;
+        __GLsync *fence;
+        uint64_t index;
+        int width;
+        int height;
+    };
+
+    struct Frame
+    {
+        uint64_t index;
+        int width;
+        int height;
+        std::vector<unsigned char> pixels;
+    };
+
+    std::vector<Readback> readbacks;
+    uint64_t next_index;
+    uint64_t oldest_index;
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable queue_cv;
+    std::condition_variable space_cv;
+    std::deque<Frame> queue;
+    std::vector<std::vector<unsigned char>> free_buffers;
+    int capacity;
+    int encoding;
+    bool stopping;
+    CaptureStats counters;
+
+    void collect(Readback &readback, bool wait);
+    void collect_ready();
+    void encode_loop();
+    void encode(Frame &frame);
+};
+
+#endif // RAYLIB_EXT_CAPTURE_HPP
@@ -0,0 +1,27 @@
+#ifndef RAYLIB_EXT_CHORDS_HPP
+#define RAYLIB_EXT_CHORDS_HPP
+
+#include <raylib-ext.hpp>
+
+/* Modular multiplication chords */
+
+// Draws count chords of the circle (center, radius): chord n joins the
+// point at angle 2*PI*n/count to the one at 2*PI*n*multiple/count, the
+// "times table" pattern.
+//
+// Endpoints are computed in the vertex shader from gl_VertexID, so nothing
+// is uploaded per frame besides a few uniforms and millions of chords stay
+// cheap. Only needs GL 3.3 core (runs on Mesa llvmpipe). If the shader
+// can't be built, the chords are computed on the CPU and drawn with
+// DrawLines().
+void
+DrawModularChords(Vector2 center, float radius, int count, float multiple, Color color);
+
+bool
+IsModularChordsGpu();
+
+// Draws on the CPU even when the shader is available, e.g. to compare both
+void
+SetModularChordsFallback(bool force);
+
+#endif // RAYLIB_EXT_CHORDS_HPP
@@ -0,0 +1,72 @@
+#ifndef RAYLIB_EXT_COMMAND_BUFFER_HPP
+#define RAYLIB_EXT_COMMAND_BUFFER_HPP
+
+#include <string>
+#include <vector>
+#include <raylib-ext.hpp>
+
+/* Draw command buffers */
+
+struct CommandVertex
+{
+    float x, y, z;
+    float u, v;
+    unsigned char r, g, b, a;
+};
+
+// Draw calls recorded as tessellated vertices, so the CPU work can run on
+// any thread. A buffer must only be filled by one thread at a time and
+// must not be recorded into while it is being submitted.
+//
+// Recording touches no GL state; textures and fonts only need to be loaded
+// (on the GL thread) before submission. SubmitCommandBuffers() runs on the
+// GL thread and draws the buffers in array order, each in recording order,
+// merging consecutive commands that share a primitive and texture.
+struct CommandBuffer
+{
+    void reset();
+
+    void line(Vector2 start, Vector2 end, Color color);
+    void line(Vector2 start, Vector2 end, float thick, Color color);
+    void bezier(Vector2 start, Vector2 control1, Vector2 control2, Vector2 end,
+                float thick, Color color, int segments = 24);
+    void triangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color);
+    void rectangle(Rectangle rec, Color color);
+    void rectangle(Rectangle rec, Vector2 origin, float rotation, Color color);
+    void circle(Vector2 center, float radius, Color color, int segments = 36);
+    void ring(Vector2 center, float innerRadius, float outerRadius, Color color,
+              int segments = 36);
+    void texture(Texture2D texture, Rectangle source, Rectangle dest, Color tint);
+    void text(Font font, const std::string &text, Vector2 position, float fontSize,
+              float spacing, Color tint);
+
+    void submit() const;
+
+    int vertex_count() const { return (int) this->vertices.size(); }
+    int command_count() const { return (int) this->commands.size(); }
+
+private:
+    struct Command
+    {
+        int mode;
+        unsigned int texture;
+        int first;
+        int count;
+    };
+
+    std::vector<CommandVertex> vertices;
+    std::vector<Command> commands;
+    std::vector<Vector2> unit_circle;
+
+    CommandVertex *push(int mode, unsigned int texture, int count);
+    const Vector2 *circle_table(int segments);
+    void quad(Vector2 p0, Vector2 p1, Vector2 p2, Vector2 p3, Color color,
+              unsigned int texture = 0, Rectangle uv = { 0, 0, 1, 1 });
+
+    friend void SubmitCommandBuffers(const CommandBuffer *buffers, int count);
+};
+
+void
+SubmitCommandBuffers(const CommandBuffer *buffers, int count);
+
+#endif // RAYLIB_EXT_COMMAND_BUFFER_HPP
@@ -0,0 +1,152 @@
+#ifndef RAYLIB_EXT_FRAME_ARENA_HPP
+#define RAYLIB_EXT_FRAME_ARENA_HPP
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include <raylib-ext.hpp>
+
+/* Frame arena */
+
+// Linear allocator for scratch data that only lives until the end of the
+// frame: point lists, vertex staging, formatted strings. Allocating bumps a
+// pointer, deallocating does nothing, and reset() releases everything at
+// once. Frame arenas reset themselves when the frame ends (EndDrawing() or
+// Clock::tick(), see raylib-ext/frame.hpp).
+//
+// When a frame needs more than the arena holds, extra blocks come from the
+// heap and the next reset() swaps them all for one block as big as that
+// frame, so a steady loop stops calling malloc after its first frames.
+//
+// A FrameArena is also a std::pmr::memory_resource:
+//
+//   std::pmr::vector<Vector2> points(&GetFrameArena());
+//   FrameVector<Vector2> points(GetFrameArena());    // same, no virtual calls
+//
+// Arenas are not thread safe and must not be in use when the frame ends.
+class FrameArena : public std::pmr::memory_resource
+{
+public:
+    explicit FrameArena(size_t capacity = 1 << 20, bool reset_at_frame_end = true);
+    FrameArena(const FrameArena &) = delete;
+    FrameArena& operator=(const FrameArena &) = delete;
+    ~FrameArena();
+
+    void *
+    allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+    {
+        size_t offset = (size_t(this->head) + alignment - 1) & ~(alignment - 1);
+        if (offset + size > size_t(this->end))
+            return allocate_slow(size, alignment);
+
+        this->head = (unsigned char *) offset + size;
+        return (void *) offset;
+    }
+
+    // Uninitialized storage for count objects
+    template <typename T>
+    T *
+    allocate_array(size_t count)
+    {
+        return (T *) allocate(count * sizeof(T), alignof(T));
+    }
+
+    // printf into the arena
+    const char *
+    format(const char *text, ...);
+
+    void reset();
+
+    size_t used() const;        // bytes handed out this frame, with padding
+    size_t capacity() const;    // bytes available without touching the heap
+    size_t peak() const;        // most bytes used by a frame so far
+
+private:
+    struct Block;
+
+    Block *blocks;              // current block first
+    unsigned char *head;
+    unsigned char *end;
+    size_t total_capacity;
+    size_t spilled;             // bytes used in the blocks behind the current one
+    size_t peak_used;
+    bool reset_at_frame_end;
+
+    void *allocate_slow(size_t size, size_t alignment);
+    void add_block(size_t size);
+    void free_blocks();
+
+    void *do_allocate(size_t size, size_t alignment) override;
+    void do_deallocate(void *ptr, size_t size, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+};
+
+// Two arenas that take turns, for data that must survive into the next
+// frame (last frame's positions, readbacks in flight). Allocations made in
+// frame N are released when frame N + 2 starts.
+class DoubleFrameArena
+{
+public:
+    explicit DoubleFrameArena(size_t capacity = 1 << 20);
+    DoubleFrameArena(const DoubleFrameArena &) = delete;
+    DoubleFrameArena& operator=(const DoubleFrameArena &) = delete;
+    ~DoubleFrameArena();
+
+    FrameArena& current() { return this->index == 0 ? this->first : this->second; }
+    FrameArena& previous() { return this->index == 0 ? this->second : this->first; }
+
+    void *
+    allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+    {
+        return current().allocate(size, alignment);
+    }
+
+    // Makes the previous frame's arena current and empties it
+    void flip();
+
+private:
+    FrameArena first;
+    FrameArena second;
+    int index;
+};
+
+// Arena shared by the main thread, 1 MiB to start with
+FrameArena&
+GetFrameArena();
+
+/* STL adapters */
+
+// Allocator for standard containers; copies share the arena
+template <typename T>
+class FrameAllocator
+{
+public:
+    typedef T value_type;
+
+    FrameAllocator(FrameArena &arena) noexcept : arena(&arena) {}
+    FrameAllocator(DoubleFrameArena &arena) noexcept : arena(&arena.current()) {}
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U> &other) noexcept : arena(other.arena) {}
+
+    T *allocate(size_t count) { return this->arena->template allocate_array<T>(count); }
+    void deallocate(T *, size_t) noexcept {}
+
+    template <typename U>
+    bool operator==(const FrameAllocator<U> &other) const noexcept { return this->arena == other.arena; }
+    template <typename U>
+    bool operator!=(const FrameAllocator<U> &other) const noexcept { return this->arena != other.arena; }
+
+private:
+    template <typename U>
+    friend class FrameAllocator;
+
+    FrameArena *arena;
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+typedef std::basic_string<char, std::char_traits<char>, FrameAllocator<char>> FrameString;
+
+#endif // RAYLIB_EXT_FRAME_ARENA_HPP
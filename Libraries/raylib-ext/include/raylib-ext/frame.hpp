@@ -0,0 +1,33 @@
+#ifndef RAYLIB_EXT_FRAME_HPP
+#define RAYLIB_EXT_FRAME_HPP
+
+#include <cstdint>
+#include <raylib-ext.hpp>
+
+/* Frame boundaries */
+
+// Frame scoped tools (profiler scopes, allocation stats, frame arenas) need
+// to know where a frame ends. raylib-ext.hpp routes BeginDrawing() and
+// EndDrawing() through FrameBeginDrawing() and FrameEndDrawing(), which end
+// the frame after raylib's EndDrawing(); okna's Clock::tick() ends it too.
+// Loops driven by something else call EndFrame() themselves, once per frame.
+
+// Closes the frame: updates the allocation stats, then runs the frame end
+// callbacks in the order they were added
+void
+EndFrame();
+
+typedef void (*FrameEndCallback)(void *data);
+
+// Callbacks must not add or remove callbacks themselves
+void
+AddFrameEndCallback(FrameEndCallback callback, void *data);
+
+void
+RemoveFrameEndCallback(FrameEndCallback callback, void *data);
+
+// Frames ended so far
+uint64_t
+GetFrameCount();
+
+#endif // RAYLIB_EXT_FRAME_HPP
@@ -0,0 +1,299 @@
+#ifndef RAYLIB_EXT_HANDLES_HPP
+#define RAYLIB_EXT_HANDLES_HPP
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include <raylib-ext.hpp>
+
+/* Resource traits */
+
+template <typename T>
+struct ResourceTraits;
+
+template <>
+struct ResourceTraits<Image>
+{
+    static bool valid(const Image &image);
+    static void unload(Image &image);
+    static Image create(int width, int height, int format);
+    static bool matches(const Image &image, int width, int height, int format);
+};
+
+template <>
+struct ResourceTraits<Texture2D>
+{
+    static bool valid(const Texture2D &texture);
+    static void unload(Texture2D &texture);
+};
+
+template <>
+struct ResourceTraits<RenderTexture2D>
+{
+    static bool valid(const RenderTexture2D &target);
+    static void unload(RenderTexture2D &target);
+    static RenderTexture2D create(int width, int height, int format);
+    static bool matches(const RenderTexture2D &target, int width, int height, int format);
+};
+
+template <>
+struct ResourceTraits<Shader>
+{
+    static bool valid(const Shader &shader);
+    static void unload(Shader &shader);
+};
+
+template <>
+struct ResourceTraits<Font>
+{
+    static bool valid(const Font &font);
+    static void unload(Font &font);
+};
+
+template <>
+struct ResourceTraits<Sound>
+{
+    static bool valid(const Sound &sound);
+    static void unload(Sound &sound);
+};
+
+template <>
+struct ResourceTraits<Music>
+{
+    static bool valid(const Music &music);
+    static void unload(Music &music);
+};
+
+template <>
+struct ResourceTraits<Wave>
+{
+    static bool valid(const Wave &wave);
+    static void unload(Wave &wave);
+};
+
+template <>
+struct ResourceTraits<Model>
+{
+    static bool valid(const Model &model);
+    static void unload(Model &model);
+};
+
+/* Owning handles */
+
+// Move-only owner of a raylib resource, unloaded when the handle goes out
+// of scope. Converts implicitly to the raw struct, so it can be passed
+// straight to raylib: DrawTexture(texture, 0, 0, WHITE).
+template <typename T>
+class Owned
+{
+public:
+    Owned() noexcept : resource() {}
+    explicit Owned(T resource) noexcept : resource(resource) {}
+    Owned(Owned &&other) noexcept : resource(other.release()) {}
+    Owned(const Owned &) = delete;
+    ~Owned() { reset(); }
+
+    Owned& operator=(Owned &&other) noexcept
+    {
+        if (this != &other)
+            reset(other.release());
+        return *this;
+    }
+    Owned& operator=(const Owned &) = delete;
+
+    T& get() noexcept { return resource; }
+    const T& get() const noexcept { return resource; }
+    operator const T&() const noexcept { return resource; }
+    T* operator->() noexcept { return &resource; }
+    const T* operator->() const noexcept { return &resource; }
+    explicit operator bool() const noexcept { return ResourceTraits<T>::valid(resource); }
+
+    T release() noexcept
+    {
+        T released = resource;
+        resource = T();
+        return released;
+    }
+
+    void reset(T replacement = T()) noexcept
+    {
+        if (ResourceTraits<T>::valid(resource))
+            ResourceTraits<T>::unload(resource);
+        resource = replacement;
+    }
+
+private:
+    T resource;
+};
+
+typedef Owned<Image> OwnedImage;
+typedef Owned<Texture2D> OwnedTexture;
+typedef Owned<RenderTexture2D> OwnedRenderTexture;
+typedef Owned<Shader> OwnedShader;
+typedef Owned<Font> OwnedFont;
+typedef Owned<Sound> OwnedSound;
+typedef Owned<Music> OwnedMusic;
+typedef Owned<Wave> OwnedWave;
+typedef Owned<Model> OwnedModel;
+
+OwnedImage
+LoadImageOwned(const std::string &fileName);
+
+OwnedTexture
+LoadTextureOwned(const std::string &fileName);
+
+OwnedTexture
+LoadTextureFromImageOwned(Image image);
+
+OwnedRenderTexture
+LoadRenderTextureOwned(int width, int height);
+
+OwnedShader
+LoadShaderOwned(const std::string &vsFileName, const std::string &fsFileName);
+
+OwnedShader
+LoadShaderFromMemoryOwned(const std::string &vsCode, const std::string &fsCode);
+
+OwnedFont
+LoadFontOwned(const std::string &fileName);
+
+OwnedFont
+LoadFontExOwned(const std::string &fileName, int fontSize, int *fontChars,
+                int glyphCount);
+
+OwnedSound
+LoadSoundOwned(const std::string &fileName);
+
+OwnedMusic
+LoadMusicStreamOwned(const std::string &fileName);
+
+OwnedWave
+LoadWaveOwned(const std::string &fileName);
+
+OwnedModel
+LoadModelOwned(const std::string &fileName);
+
+/* Resource pools */
+
+template <typename T>
+class ResourcePool;
+
+// Like Owned, but hands the resource back to its pool instead of
+// unloading it
+template <typename T>
+class Pooled
+{
+public:
+    Pooled() noexcept : pool(nullptr), resource() {}
+    Pooled(ResourcePool<T> *pool, T resource) noexcept : pool(pool), resource(resource) {}
+    Pooled(Pooled &&other) noexcept : pool(other.pool), resource(other.resource)
+    {
+        other.pool = nullptr;
+        other.resource = T();
+    }
+    Pooled(const Pooled &) = delete;
+    ~Pooled() { reset(); }
+
+    Pooled& operator=(Pooled &&other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            std::swap(pool, other.pool);
+            std::swap(resource, other.resource);
+        }
+        return *this;
+    }
+    Pooled& operator=(const Pooled &) = delete;
+
+    T& get() noexcept { return resource; }
+    const T& get() const noexcept { return resource; }
+    operator const T&() const noexcept { return resource; }
+    T* operator->() noexcept { return &resource; }
+    const T* operator->() const noexcept { return &resource; }
+    explicit operator bool() const noexcept { return ResourceTraits<T>::valid(resource); }
+
+    void reset() noexcept
+    {
+        if (pool != nullptr && ResourceTraits<T>::valid(resource))
+            pool->release(resource);
+        pool = nullptr;
+        resource = T();
+    }
+
+private:
+    ResourcePool<T> *pool;
+    T resource;
+};
+
+struct PoolStats
+{
+    size_t hits;        // acquires served from the free list
+    size_t misses;      // acquires that had to allocate
+    size_t available;   // resources waiting in the free list
+};
+
+// Free list of same-sized resources. Acquired resources keep whatever the
+// previous user left in them. The pool must outlive its Pooled handles.
+template <typename T>
+class ResourcePool
+{
+public:
+    explicit ResourcePool(size_t capacity = 16) : capacity(capacity), stats({}) {}
+    ResourcePool(const ResourcePool &) = delete;
+    ResourcePool& operator=(const ResourcePool &) = delete;
+    ~ResourcePool() { clear(); }
+
+    Pooled<T> acquire(int width, int height,
+                      int format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
+    {
+        for (size_t i = 0; i < free.size(); ++i)
+        {
+            if (ResourceTraits<T>::matches(free[i], width, height, format))
+            {
+                T resource = free[i];
+                free[i] = free.back();
+                free.pop_back();
+                stats.hits++;
+                return Pooled<T>(this, resource);
+            }
+        }
+        stats.misses++;
+        return Pooled<T>(this, ResourceTraits<T>::create(width, height, format));
+    }
+
+    void release(T resource)
+    {
+        if (free.size() < capacity)
+            free.push_back(resource);
+        else
+            ResourceTraits<T>::unload(resource);
+    }
+
+    void clear()
+    {
+        for (T &resource : free)
+            ResourceTraits<T>::unload(resource);
+        free.clear();
+    }
+
+    PoolStats get_stats() const
+    {
+        PoolStats result = stats;
+        result.available = free.size();
+        return result;
+    }
+
+private:
+    std::vector<T> free;
+    size_t capacity;
+    PoolStats stats;
+};
+
+typedef Pooled<Image> PooledImage;
+typedef Pooled<RenderTexture2D> PooledRenderTexture;
+typedef ResourcePool<Image> ImagePool;
+typedef ResourcePool<RenderTexture2D> RenderTexturePool;
+
+#endif // RAYLIB_EXT_HANDLES_HPP
@@ -0,0 +1,44 @@
+#ifndef RAYLIB_EXT_HOT_RELOAD_HPP
+#define RAYLIB_EXT_HOT_RELOAD_HPP
+
+#include <string>
+#include <raylib-ext.hpp>
+
+/* Hot reload */
+
+// A background thread waits on inotify for changes to the files behind
+// watched resources and queues them. UpdateHotReload() drains the queue on
+// the main thread, between frames, and swaps the reloaded resource into
+// the registered variable. A shader that fails to compile leaves the old
+// program in place. Nothing touches the filesystem while files are idle.
+//
+// The watched variables must stay at the same address until unwatched.
+// Only Linux is supported; elsewhere InitHotReload() returns false and the
+// other calls do nothing.
+
+bool
+InitHotReload();
+
+void
+CloseHotReload();
+
+bool
+IsHotReloadReady();
+
+void
+WatchShader(Shader *shader, const std::string &vsFileName,
+            const std::string &fsFileName);
+
+void
+WatchTexture(Texture2D *texture, const std::string &fileName);
+
+void
+WatchFont(Font *font, const std::string &fileName);
+
+void
+UnwatchResource(const void *resource);
+
+int
+UpdateHotReload();
+
+#endif // RAYLIB_EXT_HOT_RELOAD_HPP
@@ -0,0 +1,32 @@
+#ifndef RAYLIB_EXT_IMAGE_CACHE_HPP
+#define RAYLIB_EXT_IMAGE_CACHE_HPP
+
+#include <string>
+#include <raylib-ext.hpp>
+
+/* Image cache */
+
+// Decoded pixels are kept in "<fileName>.rlcache" next to the source file.
+// The cache is keyed by the source path, its modification time and size, so
+// touching or replacing the source invalidates it. A hit reads the pixel
+// block straight into Image.data and skips the PNG/JPEG decoder entirely.
+
+Image
+LoadImageCached(const std::string &fileName, bool mipmaps = false);
+
+Texture2D
+LoadTextureCached(const std::string &fileName, bool mipmaps = false);
+
+bool
+IsImageCacheValid(const std::string &fileName, bool mipmaps = false);
+
+bool
+ExportImageCache(Image image, const std::string &fileName);
+
+bool
+DeleteImageCache(const std::string &fileName);
+
+std::string
+GetImageCachePath(const std::string &fileName);
+
+#endif // RAYLIB_EXT_IMAGE_CACHE_HPP
@@ -0,0 +1,19 @@
+#ifndef RAYLIB_EXT_IMAGE_EXPORT_HPP
+#define RAYLIB_EXT_IMAGE_EXPORT_HPP
+
+#include <string>
+#include <raylib-ext.hpp>
+
+/* Parallel image export */
+
+// Drop-in replacement for ExportImage() for large images. The image is
+// split into row strips that are filtered and compressed on separate
+// threads, then stitched into a single valid file. The output format is
+// picked from the extension: .png, .qoi, .ppm or .raw.
+//
+// threads <= 0 uses every hardware thread.
+
+bool
+ExportImageParallel(Image image, const std::string &fileName, int threads = 0);
+
+#endif // RAYLIB_EXT_IMAGE_EXPORT_HPP
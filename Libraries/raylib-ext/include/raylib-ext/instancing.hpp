@@ -0,0 +1,43 @@
+#ifndef RAYLIB_EXT_INSTANCING_HPP
+#define RAYLIB_EXT_INSTANCING_HPP
+
+#include <raylib-ext.hpp>
+
+/* Instanced drawing */
+
+// Per-instance data of a 2D shape. The array is uploaded as is, so it can
+// be kept around and updated in place between frames.
+struct ShapeInstance
+{
+    Vector2 position;
+    Vector2 scale;      // radius for circles, width/height for quads
+    float rotation;     // degrees
+    Color color;
+};
+
+// Each call uploads the instance data into a persistent, orphaned buffer
+// and issues one instanced draw; the rlgl batch is flushed first so
+// layering is preserved. Without instancing support (or when forced with
+// SetInstancingFallback) the shapes are expanded on the CPU and streamed
+// in one draw, and meshes fall back to one DrawMesh() per instance.
+
+void
+DrawCirclesInstanced(const ShapeInstance *instances, int count, int segments = 36);
+
+// Quads centered on position
+void
+DrawQuadsInstanced(const ShapeInstance *instances, int count);
+
+// Multiplies the material diffuse map and color by colors[i] (nullptr for
+// WHITE). Unlit; meant for many copies of a simple mesh in BeginMode3D().
+void
+DrawMeshInstancedColored(Mesh mesh, Material material, const Matrix *transforms,
+                         const Color *colors, int count);
+
+bool
+IsInstancingSupported();
+
+void
+SetInstancingFallback(bool force);
+
+#endif // RAYLIB_EXT_INSTANCING_HPP
@@ -0,0 +1,88 @@
+#ifndef RAYLIB_EXT_PROFILER_HPP
+#define RAYLIB_EXT_PROFILER_HPP
+
+#include <cstdint>
+
+/* Scope profiler */
+
+// Records nested CPU scopes per thread and writes them as a Chrome
+// trace_event JSON file (chrome://tracing, https://ui.perfetto.dev).
+//
+// Built with -DRAYLIB_EXT_PROFILER=ON only; otherwise the macros expand to
+// nothing and the functions below do nothing. With it on, raylib-ext adds
+// scopes to BeginDrawing()..EndDrawing(), Window::sync(), Clock::tick() and
+// its asset loaders (the std::string, Cached and Owned variants).
+//
+//   PROFILE_SCOPE("name")    until the end of the enclosing block
+//   PROFILE_FUNCTION()       PROFILE_SCOPE(__func__)
+//   PROFILE_BEGIN("name")    until the matching PROFILE_END() on this thread
+//   PROFILE_END()
+//   PROFILE_THREAD("name")   names the calling thread in the trace
+//
+// Names must outlive the profiler (string literals). Each thread keeps the
+// last PROFILER_RING_EVENTS scopes in a ring buffer, so recording never
+// allocates or locks after the thread's first scope. Export while the
+// other threads are not recording.
+
+#define PROFILER_RING_EVENTS 65536
+#define PROFILER_MAX_DEPTH   64
+
+#ifdef RAYLIB_EXT_PROFILER
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+#define PROFILE_BEGIN(name) ProfileBegin(name)
+#define PROFILE_END() ProfileEnd()
+#define PROFILE_THREAD(name) SetProfileThreadName(name)
+
+#else
+
+#define PROFILE_SCOPE(name) do {} while (0)
+#define PROFILE_FUNCTION() do {} while (0)
+#define PROFILE_BEGIN(name) do {} while (0)
+#define PROFILE_END() do {} while (0)
+#define PROFILE_THREAD(name) do {} while (0)
+
+#endif
+
+// Raw timestamp: rdtsc on x86, steady_clock nanoseconds elsewhere
+uint64_t
+ProfileNow();
+
+void
+ProfileRecord(const char *name, uint64_t start, uint64_t end);
+
+void
+ProfileBegin(const char *name);
+
+void
+ProfileEnd();
+
+void
+SetProfileThreadName(const char *name);
+
+// Drops everything recorded so far, on all threads
+void
+ResetProfile();
+
+// Writes the recorded scopes of all threads; false when the profiler is
+// compiled out or the file can't be written
+bool
+ExportProfile(const char *fileName);
+
+struct ProfileScope
+{
+    const char *name;
+    uint64_t start;
+
+    ProfileScope(const char *name) : name(name), start(ProfileNow()) {}
+    ~ProfileScope() { ProfileRecord(this->name, this->start, ProfileNow()); }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+};
+
+#endif // RAYLIB_EXT_PROFILER_HPP
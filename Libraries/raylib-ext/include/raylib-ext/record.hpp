@@ -0,0 +1,38 @@
+#ifndef RAYLIB_EXT_RECORD_HPP
+#define RAYLIB_EXT_RECORD_HPP
+
+#include <raylib-ext.hpp>
+
+/* Recorded geometry */
+
+// Captures everything drawn between BeginRecord() and EndRecord() into a
+// static GPU vertex buffer instead of drawing it. DrawRecorded() replays it
+// without any CPU tessellation, usually with a single draw call (one per
+// change of primitive or texture in the recorded sequence).
+//
+// Record once, e.g. after InitWindow(), in local coordinates and WHITE; the
+// transform and tint are applied at replay. Replays use the default shader.
+
+struct RecordedGeometry
+{
+    unsigned int id;    // 0 if nothing was recorded
+    int vertex_count;
+    int draw_count;     // draw calls per replay
+};
+
+void
+BeginRecord();
+
+RecordedGeometry
+EndRecord();
+
+bool
+IsRecordedReady(RecordedGeometry recorded);
+
+void
+DrawRecorded(RecordedGeometry recorded, Matrix transform, Color tint);
+
+void
+UnloadRecorded(RecordedGeometry recorded);
+
+#endif // RAYLIB_EXT_RECORD_HPP
@@ -0,0 +1,68 @@
+#ifndef RAYLIB_EXT_RENDER_STATS_HPP
+#define RAYLIB_EXT_RENDER_STATS_HPP
+
+#include <cstdint>
+#include <raylib-ext.hpp>
+
+/* Render batch instrumentation */
+
+// Counts what reaches the GL driver each frame: draw calls, rlgl batch
+// flushes and why they happened, vertices, texture/shader switches and
+// bytes uploaded to buffers and textures.
+//
+// EnableRenderStats() must be called after InitWindow(). It hooks the GL
+// entry points used by rlgl and makes an instrumented render batch active,
+// so flush causes can be told apart:
+//
+//   vertex limit    the batch vertex buffer was (nearly) full
+//   drawcall limit  RL_DEFAULT_BATCH_DRAWCALLS texture/mode changes queued
+//   state change    shader, blend, scissor, texture mode, camera changes...
+//   frame end       the last flush before UpdateRenderStats()
+//
+// Call UpdateRenderStats() once per frame, right after EndDrawing().
+
+enum FlushCause
+{
+    FLUSH_VERTEX_LIMIT,
+    FLUSH_DRAWCALL_LIMIT,
+    FLUSH_STATE_CHANGE,
+    FLUSH_FRAME_END,
+    FLUSH_CAUSE_COUNT,
+};
+
+struct RenderStats
+{
+    int draw_calls;                      // glDraw* calls, any source
+    int flushes;                         // rlgl batch flushes
+    int flushes_by_cause[FLUSH_CAUSE_COUNT];
+    uint64_t vertices;                   // vertices submitted with draw calls
+    int texture_switches;                // binds of a different texture
+    int shader_switches;                 // binds of a different program
+    uint64_t upload_bytes;               // buffer and texture uploads
+};
+
+void
+EnableRenderStats();
+
+void
+DisableRenderStats();
+
+bool
+IsRenderStatsEnabled();
+
+void
+UpdateRenderStats();
+
+// Counters of the last completed frame
+RenderStats
+GetRenderStats();
+
+const char *
+GetFlushCauseName(FlushCause cause);
+
+// Draws the last frame's counters as a small text panel. The panel itself
+// shows up in the next frame's numbers.
+void
+DrawRenderStats(int x, int y);
+
+#endif // RAYLIB_EXT_RENDER_STATS_HPP
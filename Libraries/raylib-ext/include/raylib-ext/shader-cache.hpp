@@ -0,0 +1,38 @@
+#ifndef RAYLIB_EXT_SHADER_CACHE_HPP
+#define RAYLIB_EXT_SHADER_CACHE_HPP
+
+#include <string>
+#include <raylib-ext.hpp>
+
+/* Shader program cache */
+
+// Linked program binaries are stored in the cache directory, keyed by a
+// hash of the GLSL sources and the GL vendor/renderer/version strings. A
+// hit loads the binary with glProgramBinary() and skips compiling and
+// linking; a miss, or a binary the driver rejects, compiles from source
+// and refreshes the cache. Without program binary support (GL 4.1 or
+// ARB_get_program_binary) this is a plain LoadShaderFromMemory().
+//
+// Empty file names / code select raylib's default stage, as with
+// LoadShader().
+
+struct ShaderCacheStats
+{
+    int hits;
+    int misses;
+    int rejected;   // cached binaries refused by the driver
+};
+
+Shader
+LoadShaderCached(const std::string &vsFileName, const std::string &fsFileName);
+
+Shader
+LoadShaderFromMemoryCached(const std::string &vsCode, const std::string &fsCode);
+
+void
+SetShaderCacheDirectory(const std::string &directory);
+
+ShaderCacheStats
+GetShaderCacheStats();
+
+#endif // RAYLIB_EXT_SHADER_CACHE_HPP
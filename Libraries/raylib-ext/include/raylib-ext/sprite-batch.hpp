@@ -0,0 +1,77 @@
+#ifndef RAYLIB_EXT_SPRITE_BATCH_HPP
+#define RAYLIB_EXT_SPRITE_BATCH_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <raylib-ext.hpp>
+
+/* Sorted sprite batches */
+
+struct SpriteBatchStats
+{
+    int sprites;
+    int draw_calls_unsorted;    // draws needed in submission order
+    int draw_calls_sorted;      // draws actually issued
+    int textures;
+    int shaders;
+};
+
+// Collects sprites for a frame and draws them sorted by a 64-bit key:
+//
+//   63..56 layer    55..44 shader    43..32 texture    31..0 depth
+//
+// so every run of sprites sharing a shader and texture becomes one draw
+// call. Layers are always drawn in increasing order. Depth comes below
+// shader and texture, so it only orders sprites within one shader and
+// texture run, not across a whole layer; the sort is stable, so equal keys
+// keep their submission order. Sprites of different textures inside one
+// layer are reordered, which is what saves the draws: put overlapping
+// translucent sprites that must keep their order on separate layers.
+//
+// Layers range over -128..127. Shaders use raylib's default attribute
+// and uniform names; up to 4096 textures and shaders per frame.
+struct SpriteBatch
+{
+    void begin();
+    void end();
+
+    // Sprites drawn after this use the shader, { 0 } for the default one
+    void set_shader(Shader shader);
+
+    void draw(Texture2D texture, Vector2 position, Color tint,
+              int layer = 0, float depth = 0.0f);
+    void draw(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin,
+              float rotation, Color tint, int layer = 0, float depth = 0.0f);
+
+    SpriteBatchStats stats() const { return this->last_stats; }
+
+private:
+    struct Sprite
+    {
+        Vector2 corners[4];
+        Rectangle uv;
+        Color tint;
+    };
+
+    std::vector<Sprite> sprites;
+    std::vector<uint64_t> keys;
+    std::vector<uint64_t> key_scratch;
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> scratch;
+
+    std::vector<unsigned int> textures;
+    std::vector<Shader> shaders;
+    std::unordered_map<unsigned int, int> texture_slots;
+    std::unordered_map<unsigned int, int> shader_slots;
+    int shader_slot = 0;
+
+    uint64_t previous_state = UINT64_MAX;
+    int unsorted_draws = 0;
+    SpriteBatchStats last_stats = {};
+
+    int texture_slot(unsigned int textureId);
+    void sort();
+};
+
+#endif // RAYLIB_EXT_SPRITE_BATCH_HPP
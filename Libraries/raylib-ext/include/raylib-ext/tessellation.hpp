@@ -0,0 +1,50 @@
+#ifndef RAYLIB_EXT_TESSELLATION_HPP
+#define RAYLIB_EXT_TESSELLATION_HPP
+
+#include <raylib-ext.hpp>
+
+/* Tessellation cache */
+
+// Cached counterparts of DrawCircle(), DrawRing(), DrawRectangleRounded()
+// and DrawPoly(). Triangles are generated once per distinct shape in unit
+// space and stored; each draw only scales, rotates, translates and tints
+// them into the rlgl batch, so they batch with regular raylib drawing.
+// Rotations and sizes are not part of the cache key, so animating them
+// keeps hitting the same entries.
+//
+// A segment count <= 0 is picked from the radius on screen, taking the
+// current camera/transform scale into account, and rounded up so nearby
+// sizes share cache entries. The cache is dropped when it grows past a
+// fixed number of shapes.
+
+struct TessellationCacheStats
+{
+    int shapes;     // distinct shapes currently cached
+    int hits;
+    int misses;
+};
+
+void
+DrawCircleCached(Vector2 center, float radius, Color color);
+
+void
+DrawRingCached(Vector2 center, float innerRadius, float outerRadius,
+               float startAngle, float endAngle, int segments, Color color);
+
+void
+DrawRectangleRoundedCached(Rectangle rec, float roundness, int segments, Color color);
+
+void
+DrawPolyCached(Vector2 center, int sides, float radius, float rotation, Color color);
+
+// Segments for a full circle of this radius (before camera scaling)
+int
+GetCircleSegments(float radius);
+
+TessellationCacheStats
+GetTessellationCacheStats();
+
+void
+ClearTessellationCache();
+
+#endif // RAYLIB_EXT_TESSELLATION_HPP
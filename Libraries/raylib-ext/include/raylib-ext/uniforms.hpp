@@ -0,0 +1,86 @@
+#ifndef RAYLIB_EXT_UNIFORMS_HPP
+#define RAYLIB_EXT_UNIFORMS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <raylib-ext.hpp>
+
+/* Shader uniform tables */
+
+// FNV-1a, usable at compile time: uniforms.set(HashUniformName("time"), t)
+constexpr uint32_t
+HashUniformName(const char *name)
+{
+    uint32_t hash = 2166136261u;
+    for (; *name != '\0'; ++name)
+    {
+        hash ^= uint32_t((unsigned char) *name);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+struct UniformStats
+{
+    int sets;           // values staged with set()
+    int unchanged;      // sets that didn't change the staged value
+    int uploads;        // uniforms actually sent to GL
+    int applies;        // apply() calls, one glUseProgram each
+    int gl_calls;       // GL calls made by apply()
+    int gl_calls_saved; // versus GetShaderLocation + SetShaderValue per set
+};
+
+// Resolves uniform locations once and stages values in a CPU block;
+// apply() uploads only the values that changed since the last upload.
+// Matrices are not staged, use SetShaderValueMatrix() for those.
+class ShaderUniforms
+{
+public:
+    explicit ShaderUniforms(Shader shader);
+
+    int add(const std::string &name, int uniformType, int count = 1);
+    int find(uint32_t nameHash) const;
+
+    void set(int slot, const void *value);
+    void set(uint32_t nameHash, const void *value);
+
+    template <typename T, typename = std::enable_if_t<!std::is_pointer_v<T>>>
+    void set(int slot, const T &value) { set(slot, (const void *) &value); }
+
+    template <typename T, typename = std::enable_if_t<!std::is_pointer_v<T>>>
+    void set(uint32_t nameHash, const T &value) { set(nameHash, (const void *) &value); }
+
+    void apply();
+    void invalidate();
+
+private:
+    struct Uniform
+    {
+        std::string name;
+        uint32_t hash;
+        int location;
+        int type;
+        int count;
+        size_t offset;
+        size_t size;
+        bool dirty;
+        bool staged;    // set() was called at least once
+    };
+
+    Shader shader;
+    std::vector<Uniform> uniforms;
+    std::vector<unsigned char> block;
+};
+
+// Counters of the last finished frame, over every table (frames end at
+// EndDrawing(), see raylib-ext/frame.hpp)
+UniformStats
+GetUniformStats();
+
+void
+ResetUniformStats();
+
+#endif // RAYLIB_EXT_UNIFORMS_HPP
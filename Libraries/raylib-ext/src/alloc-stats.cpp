@@ -0,0 +1,298 @@
+#include <raylib-ext/alloc-stats.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if defined(RAYLIB_EXT_ALLOC_STATS) && (defined(__GLIBC__) || defined(__APPLE__))
+#include <execinfo.h>
+#include <unistd.h>
+#define ALLOC_STATS_BACKTRACE
+#endif
+
+// Every block starts with its size, padded to keep operator new's alignment
+#define ALLOC_HEADER_SIZE alignof(std::max_align_t)
+
+#define ALLOC_TRACE_DEPTH 32
+#define ALLOC_TRACE_SITES 256
+
+// Everything here is constant initialized: operator new runs before and
+// after any dynamic initializer of this file would
+struct AllocStatsState
+{
+    std::atomic<uint64_t> allocations { 0 };
+    std::atomic<uint64_t> frees { 0 };
+    std::atomic<uint64_t> bytes { 0 };
+    std::atomic<uint64_t> peak_bytes { 0 };
+    std::atomic<uint64_t> violations { 0 };
+    std::atomic<uint64_t> live_bytes { 0 };
+
+    AllocStats last = {};
+    bool warned = false;
+
+    std::atomic<bool> stack_traces { false };
+    std::atomic_flag trace_lock = ATOMIC_FLAG_INIT;
+    uint64_t traced_sites[ALLOC_TRACE_SITES] = {};
+    int traced_count = 0;
+};
+
+static AllocStatsState alloc_stats;
+
+static thread_local int no_alloc_depth = 0;
+static thread_local const char *no_alloc_name = nullptr;
+
+#ifdef RAYLIB_EXT_ALLOC_STATS
+
+static thread_local bool in_report = false;
+
+// Prints each distinct call site once
+static void
+report_violation(std::size_t size)
+{
+#ifdef ALLOC_STATS_BACKTRACE
+    void *frames[ALLOC_TRACE_DEPTH];
+    int depth = backtrace(frames, ALLOC_TRACE_DEPTH);
+
+    uint64_t site = 14695981039346656037ull;
+    for (int i = 0; i < depth; ++i)
+        site = (site ^ uint64_t(uintptr_t(frames[i]))) * 1099511628211ull;
+
+    while (alloc_stats.trace_lock.test_and_set(std::memory_order_acquire)) {}
+
+    bool seen = alloc_stats.traced_count == ALLOC_TRACE_SITES;
+    for (int i = 0; i < alloc_stats.traced_count && !seen; ++i)
+        seen = alloc_stats.traced_sites[i] == site;
+
+    if (!seen)
+    {
+        alloc_stats.traced_sites[alloc_stats.traced_count++] = site;
+        std::fprintf(stderr, "ALLOC: %zu bytes allocated inside no-alloc region '%s':\n",
+                     size, no_alloc_name);
+        backtrace_symbols_fd(frames, depth, STDERR_FILENO);
+    }
+
+    alloc_stats.trace_lock.clear(std::memory_order_release);
+#else
+    (void) size;
+#endif
+}
+
+static void *
+tracked_alloc(std::size_t size)
+{
+    unsigned char *block = (unsigned char *) std::malloc(size + ALLOC_HEADER_SIZE);
+    if (block == nullptr)
+        return nullptr;
+    *(std::size_t *) block = size;
+
+    alloc_stats.allocations.fetch_add(1, std::memory_order_relaxed);
+    alloc_stats.bytes.fetch_add(size, std::memory_order_relaxed);
+
+    uint64_t live = alloc_stats.live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+    uint64_t peak = alloc_stats.peak_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !alloc_stats.peak_bytes.compare_exchange_weak(
+               peak, live, std::memory_order_relaxed)) {}
+
+    if (no_alloc_depth > 0 && !in_report)
+    {
+        alloc_stats.violations.fetch_add(1, std::memory_order_relaxed);
+        if (alloc_stats.stack_traces.load(std::memory_order_relaxed))
+        {
+            in_report = true;
+            report_violation(size);
+            in_report = false;
+        }
+    }
+
+    return block + ALLOC_HEADER_SIZE;
+}
+
+static void
+tracked_free(void *ptr)
+{
+    if (ptr == nullptr)
+        return;
+
+    unsigned char *block = (unsigned char *) ptr - ALLOC_HEADER_SIZE;
+    alloc_stats.frees.fetch_add(1, std::memory_order_relaxed);
+    alloc_stats.live_bytes.fetch_sub(*(std::size_t *) block, std::memory_order_relaxed);
+    std::free(block);
+}
+
+void *
+operator new(std::size_t size)
+{
+    void *ptr = tracked_alloc(size);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void *
+operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void *
+operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    return tracked_alloc(size);
+}
+
+void *
+operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return tracked_alloc(size);
+}
+
+void
+operator delete(void *ptr) noexcept
+{
+    tracked_free(ptr);
+}
+
+void
+operator delete[](void *ptr) noexcept
+{
+    tracked_free(ptr);
+}
+
+void
+operator delete(void *ptr, std::size_t) noexcept
+{
+    tracked_free(ptr);
+}
+
+void
+operator delete[](void *ptr, std::size_t) noexcept
+{
+    tracked_free(ptr);
+}
+
+void
+operator delete(void *ptr, const std::nothrow_t &) noexcept
+{
+    tracked_free(ptr);
+}
+
+void
+operator delete[](void *ptr, const std::nothrow_t &) noexcept
+{
+    tracked_free(ptr);
+}
+
+#endif // RAYLIB_EXT_ALLOC_STATS
+
+/* Allocation stats */
+
+bool
+IsAllocStatsAvailable()
+{
+#ifdef RAYLIB_EXT_ALLOC_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void
+UpdateAllocStats()
+{
+    AllocStats &last = alloc_stats.last;
+    last.live_bytes = alloc_stats.live_bytes.load(std::memory_order_relaxed);
+    last.allocations = alloc_stats.allocations.exchange(0, std::memory_order_relaxed);
+    last.frees = alloc_stats.frees.exchange(0, std::memory_order_relaxed);
+    last.bytes = alloc_stats.bytes.exchange(0, std::memory_order_relaxed);
+    last.peak_bytes = alloc_stats.peak_bytes.exchange(last.live_bytes, std::memory_order_relaxed);
+    last.violations = alloc_stats.violations.exchange(0, std::memory_order_relaxed);
+
+    if (last.violations > 0 && !alloc_stats.warned &&
+        !alloc_stats.stack_traces.load(std::memory_order_relaxed))
+    {
+        TraceLog(LOG_WARNING, "ALLOC: %llu allocations inside no-alloc regions, "
+                 "SetNoAllocStackTraces(true) shows where", (unsigned long long) last.violations);
+        alloc_stats.warned = true;
+    }
+}
+
+AllocStats
+GetAllocStats()
+{
+    return alloc_stats.last;
+}
+
+AllocStats
+GetFrameAllocStats()
+{
+    AllocStats stats;
+    stats.allocations = alloc_stats.allocations.load(std::memory_order_relaxed);
+    stats.frees = alloc_stats.frees.load(std::memory_order_relaxed);
+    stats.bytes = alloc_stats.bytes.load(std::memory_order_relaxed);
+    stats.peak_bytes = alloc_stats.peak_bytes.load(std::memory_order_relaxed);
+    stats.live_bytes = alloc_stats.live_bytes.load(std::memory_order_relaxed);
+    stats.violations = alloc_stats.violations.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void
+BeginNoAlloc(const char *name)
+{
+    if (no_alloc_depth++ == 0)
+        no_alloc_name = name;
+}
+
+void
+EndNoAlloc()
+{
+    if (no_alloc_depth > 0)
+        no_alloc_depth--;
+}
+
+void
+SetNoAllocStackTraces(bool enabled)
+{
+#ifdef ALLOC_STATS_BACKTRACE
+    // The first backtrace() loads the unwinder, do it outside any region
+    if (enabled)
+    {
+        void *frame;
+        backtrace(&frame, 1);
+    }
+#elif defined(RAYLIB_EXT_ALLOC_STATS)
+    if (enabled)
+        TraceLog(LOG_WARNING, "ALLOC: Stack traces not available on this platform");
+#endif
+    alloc_stats.stack_traces.store(enabled, std::memory_order_relaxed);
+}
+
+void
+DrawAllocStats(int x, int y)
+{
+    const int font_size = 10;
+    const int line_height = 12;
+    const int line_count = 5;
+    const AllocStats &stats = alloc_stats.last;
+
+    if (!IsAllocStatsAvailable())
+    {
+        DrawRectangle(x, y, 170, line_height + 8, Fade(BLACK, 0.7f));
+        DrawText("alloc stats disabled", x + 4, y + 4, font_size, RAYWHITE);
+        return;
+    }
+
+    // TextFormat() only rotates through a few buffers, format each line here
+    char lines[line_count][64];
+    std::snprintf(lines[0], 64, "allocations    %llu", (unsigned long long) stats.allocations);
+    std::snprintf(lines[1], 64, "frees          %llu", (unsigned long long) stats.frees);
+    std::snprintf(lines[2], 64, "allocated      %.1f KB", stats.bytes / 1024.0);
+    std::snprintf(lines[3], 64, "peak live      %.1f KB", stats.peak_bytes / 1024.0);
+    std::snprintf(lines[4], 64, "no-alloc hits  %llu", (unsigned long long) stats.violations);
+
+    const Color color = stats.violations > 0 ? ORANGE : RAYWHITE;
+    DrawRectangle(x, y, 170, line_count * line_height + 8, Fade(BLACK, 0.7f));
+    for (int i = 0; i < line_count; ++i)
+        DrawText(lines[i], x + 4, y + 4 + i * line_height, font_size, color);
+}
@@ -0,0 +1,301 @@
+#include <raylib-ext/atlas.hpp>
+#include <raylib-ext/image-cache.hpp>
+
+#include <climits>
+#include <cstring>
+
+// Uploading the whole page beats many sub-rectangle updates past this
+#define ATLAS_FULL_UPLOAD_FRACTION 0.5f
+
+static int
+align_up(int value, int alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+TextureAtlas::TextureAtlas(int pageSize, int padding, bool mipmaps) :
+    page_size(pageSize),
+    padding(padding < 0 ? 0 : padding),
+    alignment(mipmaps ? 4 : 1),
+    mipmaps(mipmaps)
+{
+    this->page_size = align_up(this->page_size, this->alignment);
+}
+
+TextureAtlas::~TextureAtlas()
+{
+    for (Page &page : this->pages)
+    {
+        UnloadTexture(page.texture);
+        UnloadImage(page.image);
+    }
+}
+
+TextureAtlas::Page &
+TextureAtlas::add_page()
+{
+    Page page;
+    page.image = GenImageColor(this->page_size, this->page_size, BLANK);
+    page.texture = LoadTextureFromImage(page.image);
+    page.skyline.push_back(SkylineNode { 0, 0, this->page_size });
+    page.used_area = 0;
+
+    if (this->mipmaps)
+    {
+        GenTextureMipmaps(&page.texture);
+        SetTextureFilter(page.texture, TEXTURE_FILTER_TRILINEAR);
+    }
+    else
+        SetTextureFilter(page.texture, TEXTURE_FILTER_BILINEAR);
+
+    this->pages.push_back(page);
+    return this->pages.back();
+}
+
+// Lowest y at which a width x height box can sit on the skyline starting
+// at node index
+bool
+TextureAtlas::fits(const Page &page, int index, int width, int height, int &y) const
+{
+    const std::vector<SkylineNode> &skyline = page.skyline;
+    if (skyline[index].x + width > this->page_size)
+        return false;
+
+    int remaining = width;
+    y = skyline[index].y;
+    for (int i = index; remaining > 0; ++i)
+    {
+        if (i == (int) skyline.size())
+            return false;
+        if (skyline[i].y > y)
+            y = skyline[i].y;
+        if (y + height > this->page_size)
+            return false;
+        remaining -= skyline[i].width;
+    }
+    return true;
+}
+
+bool
+TextureAtlas::pack(Page &page, int width, int height, int &x, int &y)
+{
+    std::vector<SkylineNode> &skyline = page.skyline;
+
+    int best_index = -1;
+    int best_bottom = INT_MAX;
+    int best_width = INT_MAX;
+    for (int i = 0; i < (int) skyline.size(); ++i)
+    {
+        int top;
+        if (!fits(page, i, width, height, top))
+            continue;
+
+        int bottom = top + height;
+        if (bottom < best_bottom || (bottom == best_bottom && skyline[i].width < best_width))
+        {
+            best_index = i;
+            best_bottom = bottom;
+            best_width = skyline[i].width;
+            y = top;
+        }
+    }
+
+    if (best_index < 0)
+        return false;
+
+    x = skyline[best_index].x;
+    skyline.insert(skyline.begin() + best_index, SkylineNode { x, y + height, width });
+
+    // Trim the nodes the new one now covers
+    for (size_t i = best_index + 1; i < skyline.size();)
+    {
+        const SkylineNode &previous = skyline[i - 1];
+        int overlap = previous.x + previous.width - skyline[i].x;
+        if (overlap <= 0)
+            break;
+
+        skyline[i].x += overlap;
+        skyline[i].width -= overlap;
+        if (skyline[i].width > 0)
+            break;
+        skyline.erase(skyline.begin() + i);
+    }
+
+    // Merge neighbours at the same height
+    for (size_t i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else
+            ++i;
+    }
+
+    page.used_area += (long long) width * height;
+    return true;
+}
+
+// Copies the image into the page at (x, y) and extrudes its edge pixels
+// over the padding around it
+void
+TextureAtlas::blit(Page &page, Image image, int x, int y)
+{
+    Color *pixels = (Color *) page.image.data;
+    const Color *source = (const Color *) image.data;
+    const int stride = page.image.width;
+    const int pad = this->padding;
+
+    for (int row = 0; row < image.height; ++row)
+    {
+        Color *line = pixels + (y + pad + row) * stride + x;
+        const Color *from = source + row * image.width;
+
+        std::memcpy(line + pad, from, image.width * sizeof(Color));
+        for (int i = 0; i < pad; ++i)
+        {
+            line[i] = from[0];
+            line[pad + image.width + i] = from[image.width - 1];
+        }
+    }
+
+    const int width = (image.width + 2 * pad) * sizeof(Color);
+    const Color *top = pixels + (y + pad) * stride + x;
+    const Color *bottom = pixels + (y + pad + image.height - 1) * stride + x;
+    for (int i = 0; i < pad; ++i)
+    {
+        std::memcpy(pixels + (y + i) * stride + x, top, width);
+        std::memcpy(pixels + (y + pad + image.height + i) * stride + x, bottom, width);
+    }
+}
+
+int
+TextureAtlas::add(Image image)
+{
+    if (image.data == nullptr || image.width <= 0 || image.height <= 0)
+        return -1;
+
+    int width = align_up(image.width + 2 * this->padding, this->alignment);
+    int height = align_up(image.height + 2 * this->padding, this->alignment);
+    if (width > this->page_size || height > this->page_size)
+    {
+        TraceLog(LOG_WARNING, "ATLAS: Image %ix%i doesn't fit a %i page",
+                 image.width, image.height, this->page_size);
+        return -1;
+    }
+
+    Image rgba = image;
+    bool converted = image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 || image.mipmaps > 1;
+    if (converted)
+    {
+        rgba = ImageCopy(image);
+        ImageFormat(&rgba, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    }
+
+    int page_index = -1, x = 0, y = 0;
+    for (int i = 0; i < (int) this->pages.size() && page_index < 0; ++i)
+        if (pack(this->pages[i], width, height, x, y))
+            page_index = i;
+
+    if (page_index < 0)
+    {
+        pack(add_page(), width, height, x, y);
+        page_index = (int) this->pages.size() - 1;
+    }
+
+    Page &page = this->pages[page_index];
+    blit(page, rgba, x, y);
+    page.dirty.push_back(Rectangle {
+        (float) x, (float) y,
+        (float) (rgba.width + 2 * this->padding), (float) (rgba.height + 2 * this->padding)
+    });
+
+    AtlasRegion region;
+    region.page = page_index;
+    region.source = Rectangle {
+        (float) (x + this->padding), (float) (y + this->padding),
+        (float) rgba.width, (float) rgba.height
+    };
+    this->regions.push_back(region);
+
+    if (converted)
+        UnloadImage(rgba);
+
+    return (int) this->regions.size() - 1;
+}
+
+int
+TextureAtlas::add(const std::string &fileName)
+{
+    Image image = LoadImageCached(fileName);
+    if (image.data == nullptr)
+        return -1;
+
+    int id = add(image);
+    UnloadImage(image);
+    return id;
+}
+
+void
+TextureAtlas::upload()
+{
+    for (Page &page : this->pages)
+    {
+        if (page.dirty.empty())
+            continue;
+
+        float area = 0.0f;
+        for (const Rectangle &rect : page.dirty)
+            area += rect.width * rect.height;
+
+        if (area > ATLAS_FULL_UPLOAD_FRACTION * this->page_size * this->page_size)
+            UpdateTexture(page.texture, page.image.data);
+        else
+        {
+            for (const Rectangle &rect : page.dirty)
+            {
+                Image part = ImageFromImage(page.image, rect);
+                UpdateTextureRec(page.texture, rect, part.data);
+                UnloadImage(part);
+            }
+        }
+
+        if (this->mipmaps)
+            GenTextureMipmaps(&page.texture);
+
+        page.dirty.clear();
+    }
+}
+
+float
+TextureAtlas::occupancy(int page) const
+{
+    return float(this->pages[page].used_area) / (float(this->page_size) * this->page_size);
+}
+
+void
+TextureAtlas::draw(int id, Vector2 position, Color tint)
+{
+    const AtlasRegion &region = this->regions[id];
+    Rectangle dest = { position.x, position.y, region.source.width, region.source.height };
+    draw(id, dest, { 0, 0 }, 0.0f, tint);
+}
+
+void
+TextureAtlas::draw(int id, Rectangle dest, Vector2 origin, float rotation, Color tint)
+{
+    upload();
+    const AtlasRegion &region = this->regions[id];
+    DrawTexturePro(this->pages[region.page].texture, region.source, dest, origin, rotation, tint);
+}
+
+void
+TextureAtlas::draw(SpriteBatch &batch, int id, Rectangle dest, Vector2 origin, float rotation,
+                   Color tint, int layer, float depth)
+{
+    upload();
+    const AtlasRegion &region = this->regions[id];
+    batch.draw(this->pages[region.page].texture, region.source, dest, origin, rotation,
+               tint, layer, depth);
+}
@@ -0,0 +1,169 @@
+#include <raylib-ext/batch-draw.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "stream.hpp"
+
+static Color
+color_at(const Color *colors, int index, Color fallback)
+{
+    return colors != nullptr ? colors[index] : fallback;
+}
+
+static StreamVertex *
+emit_quad(StreamVertex *out, float x0, float y0, float x1, float y1, Color color)
+{
+    // Same winding as DrawRectanglePro() so back face culling agrees
+    *out++ = StreamMakeVertex(x0, y0, color);
+    *out++ = StreamMakeVertex(x0, y1, color);
+    *out++ = StreamMakeVertex(x1, y1, color);
+    *out++ = StreamMakeVertex(x0, y0, color);
+    *out++ = StreamMakeVertex(x1, y1, color);
+    *out++ = StreamMakeVertex(x1, y0, color);
+    return out;
+}
+
+static const std::vector<Vector2> &
+unit_circle(int segments)
+{
+    static std::vector<Vector2> table;
+    static int table_segments = 0;
+
+    if (table_segments != segments)
+    {
+        table.resize(segments + 1);
+        for (int i = 0; i <= segments; ++i)
+        {
+            float angle = 2.0f * PI * i / segments;
+            table[i] = Vector2 { std::cos(angle), std::sin(angle) };
+        }
+        table_segments = segments;
+    }
+    return table;
+}
+
+static void
+draw_lines(const Vector2 *points, const Color *colors, int pointCount, Color color)
+{
+    pointCount &= ~1;
+    if (points == nullptr || pointCount <= 0)
+        return;
+
+    StreamVertex *vertices = StreamReserve(pointCount);
+    for (int i = 0; i < pointCount; ++i)
+    {
+        Color c = color_at(colors, i / 2, color);
+        vertices[i] = StreamMakeVertex(points[i].x, points[i].y, c);
+    }
+    StreamDraw(STREAM_LINES, vertices, pointCount);
+}
+
+static void
+draw_circles(const Vector2 *centers, const float *radii, const Color *colors,
+             int count, int segments, Color color)
+{
+    if (centers == nullptr || radii == nullptr || count <= 0)
+        return;
+    if (segments < 3)
+        segments = 3;
+
+    const std::vector<Vector2> &circle = unit_circle(segments);
+    StreamVertex *vertices = StreamReserve(count * segments * 3);
+    StreamVertex *out = vertices;
+
+    for (int i = 0; i < count; ++i)
+    {
+        Vector2 center = centers[i];
+        float radius = radii[i];
+        Color c = color_at(colors, i, color);
+
+        for (int s = 0; s < segments; ++s)
+        {
+            *out++ = StreamMakeVertex(center.x, center.y, c);
+            *out++ = StreamMakeVertex(center.x + circle[s + 1].x * radius,
+                                      center.y + circle[s + 1].y * radius, c);
+            *out++ = StreamMakeVertex(center.x + circle[s].x * radius,
+                                      center.y + circle[s].y * radius, c);
+        }
+    }
+    StreamDraw(STREAM_TRIANGLES, vertices, int(out - vertices));
+}
+
+static void
+draw_rects(const Rectangle *rects, const Color *colors, int count, Color color)
+{
+    if (rects == nullptr || count <= 0)
+        return;
+
+    StreamVertex *vertices = StreamReserve(count * 6);
+    StreamVertex *out = vertices;
+
+    for (int i = 0; i < count; ++i)
+    {
+        const Rectangle &r = rects[i];
+        Color c = color_at(colors, i, color);
+        float x0 = r.x, y0 = r.y, x1 = r.x + r.width, y1 = r.y + r.height;
+
+        out = emit_quad(out, x0, y0, x1, y1, c);
+    }
+    StreamDraw(STREAM_TRIANGLES, vertices, int(out - vertices));
+}
+
+void
+DrawLines(const Vector2 *points, int pointCount, Color color)
+{
+    draw_lines(points, nullptr, pointCount, color);
+}
+
+void
+DrawLines(const Vector2 *points, const Color *colors, int pointCount)
+{
+    draw_lines(points, colors, pointCount, WHITE);
+}
+
+void
+DrawPoints(const Vector2 *points, int count, float size, Color color)
+{
+    if (points == nullptr || count <= 0)
+        return;
+
+    float half = size * 0.5f;
+    StreamVertex *vertices = StreamReserve(count * 6);
+    StreamVertex *out = vertices;
+
+    for (int i = 0; i < count; ++i)
+    {
+        float x0 = points[i].x - half, y0 = points[i].y - half;
+        float x1 = points[i].x + half, y1 = points[i].y + half;
+
+        out = emit_quad(out, x0, y0, x1, y1, color);
+    }
+    StreamDraw(STREAM_TRIANGLES, vertices, int(out - vertices));
+}
+
+void
+DrawCircles(const Vector2 *centers, const float *radii, int count, Color color,
+            int segments)
+{
+    draw_circles(centers, radii, nullptr, count, segments, color);
+}
+
+void
+DrawCircles(const Vector2 *centers, const float *radii, const Color *colors,
+            int count, int segments)
+{
+    draw_circles(centers, radii, colors, count, segments, WHITE);
+}
+
+void
+DrawRects(const Rectangle *rects, int count, Color color)
+{
+    draw_rects(rects, nullptr, count, color);
+}
+
+void
+DrawRects(const Rectangle *rects, const Color *colors, int count)
+{
+    draw_rects(rects, colors, count, WHITE);
+}
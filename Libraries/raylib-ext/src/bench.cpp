@@ -0,0 +1,27 @@
+#include <raylib-ext/bench.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+double
+BenchNowMs()
+{
+    using namespace std::chrono;
+    return duration<double, std::milli>(
+        steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+std::vector<int>
+BenchThreadCounts(int max_threads)
+{
+    if (max_threads < 1)
+        max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<int> counts;
+    for (int threads = 1; threads < max_threads; threads *= 2)
+        counts.push_back(threads);
+    counts.push_back(max_threads);
+    return counts;
+}
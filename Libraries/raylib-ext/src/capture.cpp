@@ -0,0 +1,277 @@
+#include <raylib-ext/capture.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#include <glad/glad.h>
+
+#define CAPTURE_WAIT_NS 1000000000ull
+
+FrameCapture::FrameCapture(const std::string &directory, CaptureFormat format,
+                           int readback_buffers, int workers, int max_queued,
+                           bool drop_when_full) :
+    directory(directory),
+    prefix("frame-"),
+    format(format),
+    drop_when_full(drop_when_full),
+    next_index(0),
+    oldest_index(0),
+    encoding(0),
+    stopping(false),
+    counters({})
+{
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    readback_buffers = std::max(readback_buffers, 2);
+    if (workers <= 0)
+        workers = std::max(1, int(std::thread::hardware_concurrency()) - 1);
+    this->capacity = max_queued > 0 ? max_queued : workers * 2 + readback_buffers;
+
+    this->readbacks.resize(readback_buffers);
+    for (Readback &readback : this->readbacks)
+    {
+        glGenBuffers(1, &readback.pbo);
+        readback.fence = nullptr;
+        readback.index = 0;
+        readback.width = 0;
+        readback.height = 0;
+    }
+
+    for (int i = 0; i < workers; ++i)
+        this->workers.emplace_back(&FrameCapture::encode_loop, this);
+}
+
+FrameCapture::~FrameCapture()
+{
+    finish();
+}
+
+void
+FrameCapture::grab()
+{
+    if (this->stopping)
+        return;
+
+    // Make sure everything raylib has batched so far is in the framebuffer
+    rlDrawRenderBatchActive();
+
+    int width = GetRenderWidth();
+    int height = GetRenderHeight();
+
+    collect_ready();
+
+    Readback &slot = this->readbacks[this->next_index % this->readbacks.size()];
+    if (slot.fence != nullptr)
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->counters.stalls++;
+        }
+        collect(slot, true);
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    if (slot.width != width || slot.height != height)
+    {
+        glBufferData(GL_PIXEL_PACK_BUFFER, GLsizeiptr(width) * height * 4,
+                     nullptr, GL_STREAM_READ);
+        slot.width = width;
+        slot.height = height;
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.index = this->next_index++;
+}
+
+void
+FrameCapture::finish()
+{
+    if (this->workers.empty())
+        return;
+
+    while (this->oldest_index < this->next_index)
+    {
+        Readback &slot = this->readbacks[this->oldest_index % this->readbacks.size()];
+        collect(slot, true);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->space_cv.wait(lock, [this] {
+            return this->queue.empty() && this->encoding == 0;
+        });
+        this->stopping = true;
+    }
+    this->queue_cv.notify_all();
+
+    for (std::thread &worker : this->workers)
+        worker.join();
+    this->workers.clear();
+
+    for (Readback &readback : this->readbacks)
+        glDeleteBuffers(1, &readback.pbo);
+    this->readbacks.clear();
+}
+
+CaptureStats
+FrameCapture::stats()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    CaptureStats stats = this->counters;
+    stats.queued = int(this->queue.size());
+    stats.capacity = this->capacity;
+    return stats;
+}
+
+bool
+FrameCapture::backpressure()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return int(this->queue.size()) * 4 >= this->capacity * 3;
+}
+
+void
+FrameCapture::collect(Readback &readback, bool wait)
+{
+    if (wait)
+    {
+        while (glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                CAPTURE_WAIT_NS) == GL_TIMEOUT_EXPIRED);
+    }
+    glDeleteSync(readback.fence);
+    readback.fence = nullptr;
+    this->oldest_index = readback.index + 1;
+
+    Frame frame;
+    frame.index = readback.index;
+    frame.width = readback.width;
+    frame.height = readback.height;
+    size_t size = size_t(frame.width) * frame.height * 4;
+
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->counters.captured++;
+        if (int(this->queue.size()) >= this->capacity)
+        {
+            if (this->drop_when_full)
+            {
+                this->counters.dropped++;
+                return;
+            }
+            this->counters.blocked++;
+            this->space_cv.wait(lock, [this] {
+                return int(this->queue.size()) < this->capacity;
+            });
+        }
+        if (!this->free_buffers.empty())
+        {
+            frame.pixels = std::move(this->free_buffers.back());
+            this->free_buffers.pop_back();
+        }
+    }
+    frame.pixels.resize(size);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pbo);
+    void *pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, GLsizeiptr(size),
+                                    GL_MAP_READ_BIT);
+    if (pixels != nullptr)
+    {
+        std::memcpy(frame.pixels.data(), pixels, size);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->queue.push_back(std::move(frame));
+    }
+    this->queue_cv.notify_one();
+}
+
+void
+FrameCapture::collect_ready()
+{
+    while (this->oldest_index < this->next_index)
+    {
+        Readback &slot = this->readbacks[this->oldest_index % this->readbacks.size()];
+        GLenum status = glClientWaitSync(slot.fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+            break;
+        collect(slot, false);
+    }
+}
+
+void
+FrameCapture::encode_loop()
+{
+    for (;;)
+    {
+        Frame frame;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->queue_cv.wait(lock, [this] {
+                return this->stopping || !this->queue.empty();
+            });
+            if (this->queue.empty())
+                return;
+            frame = std::move(this->queue.front());
+            this->queue.pop_front();
+            this->encoding++;
+        }
+        this->space_cv.notify_all();
+
+        encode(frame);
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->encoding--;
+            this->counters.written++;
+            this->free_buffers.push_back(std::move(frame.pixels));
+        }
+        this->space_cv.notify_all();
+    }
+}
+
+void
+FrameCapture::encode(Frame &frame)
+{
+    // GL reads bottom-up; flip to top-down and drop the framebuffer alpha
+    size_t stride = size_t(frame.width) * 4;
+    unsigned char *data = frame.pixels.data();
+    for (int top = 0, bottom = frame.height - 1; top <= bottom; ++top, --bottom)
+    {
+        unsigned char *a = data + top * stride;
+        unsigned char *b = data + bottom * stride;
+        for (size_t i = 0; i < stride; i += 4)
+        {
+            std::swap_ranges(a + i, a + i + 3, b + i);
+            a[i + 3] = 255;
+            b[i + 3] = 255;
+        }
+    }
+
+    static const char *extensions[] = { ".png", ".qoi", ".raw" };
+    char number[32];
+    std::snprintf(number, sizeof(number), "%06llu", (unsigned long long) frame.index);
+    std::string path = this->directory + "/" + this->prefix + number
+                     + extensions[this->format];
+
+    if (this->format == CAPTURE_RAW)
+    {
+        SaveFileData(path, data, (unsigned int) frame.pixels.size());
+    }
+    else
+    {
+        Image image = {
+            data, frame.width, frame.height, 1,
+            PIXELFORMAT_UNCOMPRESSED_R8G8B8A8
+        };
+        ExportImage(image, path);
+    }
+}
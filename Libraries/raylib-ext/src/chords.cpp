@@ -0,0 +1,188 @@
+#include <raylib-ext/chords.hpp>
+#include <raylib-ext/batch-draw.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "stream.hpp"
+
+// The integer part of multiple is applied modulo count in integers, so
+// the angles stay exact for large n where n*multiple overflows float
+// precision. n*whole reaches count squared, past 32 bits once count is over
+// 65536, so large counts multiply by doubling and adding: with both
+// factors below count < 2^31, no sum exceeds 32 bits.
+static const char *chords_vs = R"(#version 330
+uniform mat4 mvp;
+uniform vec2 center;
+uniform float radius;
+uniform float multiple;
+uniform int count;
+uint mulmod(uint a, uint b, uint m)
+{
+    if (m <= 65536u)
+        return (a*b) % m;
+    uint result = 0u;
+    while (b > 0u)
+    {
+        if ((b & 1u) == 1u)
+        {
+            result += a;
+            if (result >= m) result -= m;
+        }
+        a += a;
+        if (a >= m) a -= m;
+        b >>= 1;
+    }
+    return result;
+}
+void main()
+{
+    int n = gl_VertexID/2;
+    float turns = float(n)/float(count);
+    if ((gl_VertexID & 1) == 1)
+    {
+        int whole = int(floor(multiple));
+        float part = multiple - float(whole);
+        int wrapped = int(mulmod(uint(n), uint(whole), uint(count)));
+        turns = fract(float(wrapped)/float(count) + float(n)*part/float(count));
+    }
+    float angle = 6.28318530718*turns;
+    gl_Position = mvp*vec4(center + vec2(cos(angle), sin(angle))*radius, 0.0, 1.0);
+}
+)";
+
+static const char *chords_fs = R"(#version 330
+uniform vec4 color;
+out vec4 finalColor;
+void main()
+{
+    finalColor = color;
+}
+)";
+
+struct Chords
+{
+    bool initialized = false;
+    bool forced_fallback = false;
+    GLuint program = 0;
+    GLuint vao = 0;
+    GLint mvp = -1;
+    GLint center = -1;
+    GLint radius = -1;
+    GLint multiple = -1;
+    GLint count = -1;
+    GLint color = -1;
+    std::vector<Vector2> points;
+};
+
+static Chords chords;
+
+static void
+init_chords()
+{
+    chords.initialized = true;
+
+    GLuint program = rlLoadShaderCode(chords_vs, chords_fs);
+    if (program == rlGetShaderIdDefault())
+    {
+        TraceLog(LOG_WARNING, "CHORDS: Failed to build shader, using CPU fallback");
+        return;
+    }
+
+    chords.program = program;
+    chords.mvp = glGetUniformLocation(program, "mvp");
+    chords.center = glGetUniformLocation(program, "center");
+    chords.radius = glGetUniformLocation(program, "radius");
+    chords.multiple = glGetUniformLocation(program, "multiple");
+    chords.count = glGetUniformLocation(program, "count");
+    chords.color = glGetUniformLocation(program, "color");
+
+    // Core profile needs a vertex array bound even with no attributes
+    glGenVertexArrays(1, &chords.vao);
+}
+
+// Adding count to multiple gives the same chords, keep it small for the
+// integer math
+static double
+wrap_multiple(float multiple, int count)
+{
+    double wrapped = std::fmod((double) multiple, (double) count);
+    if (wrapped < 0)
+        wrapped += count;
+    return wrapped;
+}
+
+// The same split as the shader, in 64 bits, so it is exact at any count
+static void
+draw_chords_cpu(Vector2 center, float radius, int count, float multiple, Color color)
+{
+    const double wrapped = wrap_multiple(multiple, count);
+    const int64_t whole = (int64_t) std::floor(wrapped);
+    const double part = wrapped - (double) whole;
+    chords.points.resize(count * 2);
+
+    for (int n = 0; n < count; ++n)
+    {
+        double start = 2.0 * PI * n / count;
+        double turns = ((n * whole) % count + n * part) / count;
+        double end = 2.0 * PI * (turns - std::floor(turns));
+
+        chords.points[n * 2] = Vector2 {
+            (float) std::cos(start), (float) std::sin(start)
+        } * radius + center;
+        chords.points[n * 2 + 1] = Vector2 {
+            (float) std::cos(end), (float) std::sin(end)
+        } * radius + center;
+    }
+
+    DrawLines(chords.points.data(), count * 2, color);
+}
+
+void
+DrawModularChords(Vector2 center, float radius, int count, float multiple, Color color)
+{
+    if (count <= 0)
+        return;
+
+    if (!chords.initialized)
+        init_chords();
+
+    if (chords.program == 0 || chords.forced_fallback)
+    {
+        draw_chords_cpu(center, radius, count, multiple, color);
+        return;
+    }
+
+    rlDrawRenderBatchActive();
+
+    glUseProgram(chords.program);
+    glUniformMatrix4fv(chords.mvp, 1, GL_FALSE, MatrixToFloat(StreamGetMatrixMVP()));
+    glUniform2f(chords.center, center.x, center.y);
+    glUniform1f(chords.radius, radius);
+    glUniform1f(chords.multiple, (float) wrap_multiple(multiple, count));
+    glUniform1i(chords.count, count);
+    glUniform4f(chords.color, color.r / 255.0f, color.g / 255.0f,
+                color.b / 255.0f, color.a / 255.0f);
+
+    glBindVertexArray(chords.vao);
+    glDrawArrays(GL_LINES, 0, count * 2);
+    glBindVertexArray(0);
+    glUseProgram(0);
+}
+
+bool
+IsModularChordsGpu()
+{
+    if (!chords.initialized)
+        init_chords();
+    return chords.program != 0;
+}
+
+void
+SetModularChordsFallback(bool force)
+{
+    chords.forced_fallback = force;
+}
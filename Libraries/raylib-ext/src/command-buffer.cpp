@@ -0,0 +1,325 @@
+#include <raylib-ext/command-buffer.hpp>
+
+#include <cmath>
+#include <cstring>
+
+#include "stream.hpp"
+
+static_assert(sizeof(CommandVertex) == sizeof(StreamVertex),
+              "CommandVertex must match the stream vertex layout");
+
+static CommandVertex
+make_vertex(Vector2 position, Color color, float u = 0.0f, float v = 0.0f)
+{
+    return CommandVertex { position.x, position.y, 0.0f, u, v,
+                           color.r, color.g, color.b, color.a };
+}
+
+void
+CommandBuffer::reset()
+{
+    this->vertices.clear();
+    this->commands.clear();
+}
+
+CommandVertex *
+CommandBuffer::push(int mode, unsigned int texture, int count)
+{
+    int first = (int) this->vertices.size();
+    this->vertices.resize(first + count);
+
+    if (!this->commands.empty())
+    {
+        Command &last = this->commands.back();
+        if (last.mode == mode && last.texture == texture)
+        {
+            last.count += count;
+            return this->vertices.data() + first;
+        }
+    }
+
+    this->commands.push_back(Command { mode, texture, first, count });
+    return this->vertices.data() + first;
+}
+
+const Vector2 *
+CommandBuffer::circle_table(int segments)
+{
+    if ((int) this->unit_circle.size() != segments + 1)
+    {
+        this->unit_circle.resize(segments + 1);
+        for (int i = 0; i <= segments; ++i)
+        {
+            float angle = 2.0f * PI * i / segments;
+            this->unit_circle[i] = Vector2 { std::cos(angle), std::sin(angle) };
+        }
+    }
+    return this->unit_circle.data();
+}
+
+// Corners go top-left, bottom-left, bottom-right, top-right, the same
+// winding as DrawTexturePro() so back face culling agrees
+void
+CommandBuffer::quad(Vector2 p0, Vector2 p1, Vector2 p2, Vector2 p3, Color color,
+                    unsigned int texture, Rectangle uv)
+{
+    float u0 = uv.x, v0 = uv.y;
+    float u1 = uv.x + uv.width, v1 = uv.y + uv.height;
+
+    CommandVertex *out = push(STREAM_TRIANGLES, texture, 6);
+    out[0] = make_vertex(p0, color, u0, v0);
+    out[1] = make_vertex(p1, color, u0, v1);
+    out[2] = make_vertex(p2, color, u1, v1);
+    out[3] = make_vertex(p0, color, u0, v0);
+    out[4] = make_vertex(p2, color, u1, v1);
+    out[5] = make_vertex(p3, color, u1, v0);
+}
+
+void
+CommandBuffer::line(Vector2 start, Vector2 end, Color color)
+{
+    CommandVertex *out = push(STREAM_LINES, 0, 2);
+    out[0] = make_vertex(start, color);
+    out[1] = make_vertex(end, color);
+}
+
+void
+CommandBuffer::line(Vector2 start, Vector2 end, float thick, Color color)
+{
+    Vector2 delta = end - start;
+    float length = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+    if (length <= 0.0f || thick <= 0.0f)
+        return;
+
+    float scale = thick / (2.0f * length);
+    Vector2 radius = { -delta.y * scale, delta.x * scale };
+
+    quad(start - radius, start + radius, end + radius, end - radius, color);
+}
+
+void
+CommandBuffer::bezier(Vector2 start, Vector2 control1, Vector2 control2, Vector2 end,
+                      float thick, Color color, int segments)
+{
+    if (segments < 1)
+        segments = 1;
+
+    Vector2 previous = start;
+    Vector2 previous_normal = {};
+
+    for (int i = 0; i <= segments; ++i)
+    {
+        float t = float(i) / segments;
+        float s = 1.0f - t;
+
+        Vector2 point = start * (s * s * s) + control1 * (3.0f * s * s * t)
+            + control2 * (3.0f * s * t * t) + end * (t * t * t);
+        Vector2 tangent = (control1 - start) * (3.0f * s * s)
+            + (control2 - control1) * (6.0f * s * t) + (end - control2) * (3.0f * t * t);
+
+        float length = std::sqrt(tangent.x * tangent.x + tangent.y * tangent.y);
+        if (length <= 0.0f)
+        {
+            tangent = end - start;
+            length = std::sqrt(tangent.x * tangent.x + tangent.y * tangent.y);
+            if (length <= 0.0f)
+                return;
+        }
+
+        float scale = thick / (2.0f * length);
+        Vector2 normal = { -tangent.y * scale, tangent.x * scale };
+
+        if (i > 0)
+            quad(previous - previous_normal, previous + previous_normal,
+                 point + normal, point - normal, color);
+
+        previous = point;
+        previous_normal = normal;
+    }
+}
+
+void
+CommandBuffer::triangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color)
+{
+    CommandVertex *out = push(STREAM_TRIANGLES, 0, 3);
+    out[0] = make_vertex(v1, color);
+    out[1] = make_vertex(v2, color);
+    out[2] = make_vertex(v3, color);
+}
+
+void
+CommandBuffer::rectangle(Rectangle rec, Color color)
+{
+    quad({ rec.x, rec.y }, { rec.x, rec.y + rec.height },
+         { rec.x + rec.width, rec.y + rec.height }, { rec.x + rec.width, rec.y },
+         color);
+}
+
+void
+CommandBuffer::rectangle(Rectangle rec, Vector2 origin, float rotation, Color color)
+{
+    float sin_r = std::sin(rotation * DEG2RAD);
+    float cos_r = std::cos(rotation * DEG2RAD);
+    float dx = -origin.x, dy = -origin.y;
+
+    auto corner = [&](float x, float y) {
+        return Vector2 { rec.x + x * cos_r - y * sin_r, rec.y + x * sin_r + y * cos_r };
+    };
+
+    quad(corner(dx, dy), corner(dx, dy + rec.height),
+         corner(dx + rec.width, dy + rec.height), corner(dx + rec.width, dy), color);
+}
+
+void
+CommandBuffer::circle(Vector2 center, float radius, Color color, int segments)
+{
+    if (segments < 3)
+        segments = 3;
+
+    const Vector2 *table = circle_table(segments);
+    CommandVertex *out = push(STREAM_TRIANGLES, 0, segments * 3);
+
+    for (int s = 0; s < segments; ++s)
+    {
+        *out++ = make_vertex(center, color);
+        *out++ = make_vertex(center + table[s + 1] * radius, color);
+        *out++ = make_vertex(center + table[s] * radius, color);
+    }
+}
+
+void
+CommandBuffer::ring(Vector2 center, float innerRadius, float outerRadius, Color color,
+                    int segments)
+{
+    if (segments < 3)
+        segments = 3;
+
+    const Vector2 *table = circle_table(segments);
+    CommandVertex *out = push(STREAM_TRIANGLES, 0, segments * 6);
+
+    for (int s = 0; s < segments; ++s)
+    {
+        Vector2 inner0 = center + table[s] * innerRadius;
+        Vector2 inner1 = center + table[s + 1] * innerRadius;
+        Vector2 outer0 = center + table[s] * outerRadius;
+        Vector2 outer1 = center + table[s + 1] * outerRadius;
+
+        *out++ = make_vertex(inner0, color);
+        *out++ = make_vertex(outer1, color);
+        *out++ = make_vertex(outer0, color);
+        *out++ = make_vertex(inner0, color);
+        *out++ = make_vertex(inner1, color);
+        *out++ = make_vertex(outer1, color);
+    }
+}
+
+void
+CommandBuffer::texture(Texture2D texture, Rectangle source, Rectangle dest, Color tint)
+{
+    if (texture.id == 0 || texture.width == 0 || texture.height == 0)
+        return;
+
+    Rectangle uv = {
+        source.x / texture.width, source.y / texture.height,
+        source.width / texture.width, source.height / texture.height
+    };
+
+    quad({ dest.x, dest.y }, { dest.x, dest.y + dest.height },
+         { dest.x + dest.width, dest.y + dest.height }, { dest.x + dest.width, dest.y },
+         tint, texture.id, uv);
+}
+
+// Same layout rules as DrawTextEx()
+void
+CommandBuffer::text(Font font, const std::string &text, Vector2 position, float fontSize,
+                    float spacing, Color tint)
+{
+    if (font.texture.id == 0 || font.baseSize == 0)
+        return;
+
+    float scale = fontSize / font.baseSize;
+    float padding = (float) font.glyphPadding;
+    float offset_x = 0.0f;
+    float offset_y = 0.0f;
+
+    for (size_t i = 0; i < text.size();)
+    {
+        int bytes = 0;
+        int codepoint = GetCodepoint(&text[i], &bytes);
+        int index = GetGlyphIndex(font, codepoint);
+
+        // GetCodepoint() returns '?' for invalid sequences, skip one byte
+        if (codepoint == 0x3f || bytes <= 0)
+            bytes = 1;
+
+        if (codepoint == '\n')
+        {
+            offset_y += float(int((font.baseSize + font.baseSize / 2) * scale));
+            offset_x = 0.0f;
+            i += bytes;
+            continue;
+        }
+
+        const Rectangle &rec = font.recs[index];
+        const GlyphInfo &glyph = font.glyphs[index];
+
+        if (codepoint != ' ' && codepoint != '\t')
+        {
+            Rectangle source = {
+                rec.x - padding, rec.y - padding,
+                rec.width + 2.0f * padding, rec.height + 2.0f * padding
+            };
+            Rectangle dest = {
+                position.x + offset_x + (glyph.offsetX - padding) * scale,
+                position.y + offset_y + (glyph.offsetY - padding) * scale,
+                source.width * scale, source.height * scale
+            };
+            texture(font.texture, source, dest, tint);
+        }
+
+        offset_x += (glyph.advanceX == 0 ? rec.width : glyph.advanceX) * scale + spacing;
+        i += bytes;
+    }
+}
+
+void
+CommandBuffer::submit() const
+{
+    SubmitCommandBuffers(this, 1);
+}
+
+void
+SubmitCommandBuffers(const CommandBuffer *buffers, int count)
+{
+    static std::vector<StreamVertex> merged;
+
+    int mode = STREAM_TRIANGLES;
+    unsigned int texture = 0;
+    merged.clear();
+
+    auto flush = [&]() {
+        StreamDraw(StreamMode(mode), merged.data(), (int) merged.size(), texture);
+        merged.clear();
+    };
+
+    for (int b = 0; b < count; ++b)
+    {
+        const CommandBuffer &buffer = buffers[b];
+        for (const CommandBuffer::Command &command : buffer.commands)
+        {
+            if (!merged.empty() && (command.mode != mode || command.texture != texture))
+                flush();
+
+            mode = command.mode;
+            texture = command.texture;
+
+            size_t at = merged.size();
+            merged.resize(at + command.count);
+            std::memcpy(&merged[at], &buffer.vertices[command.first],
+                        command.count * sizeof(StreamVertex));
+        }
+    }
+
+    if (!merged.empty())
+        flush();
+}
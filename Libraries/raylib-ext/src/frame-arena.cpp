@@ -0,0 +1,207 @@
+#include <raylib-ext/frame-arena.hpp>
+#include <raylib-ext/frame.hpp>
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+struct FrameArena::Block
+{
+    Block *next;
+    size_t size;
+};
+
+// Block data starts after the header, aligned like malloc'd memory
+#define FRAME_ARENA_HEADER_SIZE alignof(std::max_align_t)
+
+static unsigned char *
+block_data(void *block)
+{
+    return (unsigned char *) block + FRAME_ARENA_HEADER_SIZE;
+}
+
+static void
+reset_frame_arena(void *arena)
+{
+    ((FrameArena *) arena)->reset();
+}
+
+static void
+flip_frame_arena(void *arena)
+{
+    ((DoubleFrameArena *) arena)->flip();
+}
+
+/* Frame arena */
+
+FrameArena::FrameArena(size_t capacity, bool reset_at_frame_end) :
+    blocks(nullptr),
+    head(nullptr),
+    end(nullptr),
+    total_capacity(0),
+    spilled(0),
+    peak_used(0),
+    reset_at_frame_end(reset_at_frame_end)
+{
+    if (capacity > 0)
+        add_block(capacity);
+    if (reset_at_frame_end)
+        AddFrameEndCallback(reset_frame_arena, this);
+}
+
+FrameArena::~FrameArena()
+{
+    if (this->reset_at_frame_end)
+        RemoveFrameEndCallback(reset_frame_arena, this);
+    free_blocks();
+}
+
+void *
+FrameArena::allocate_slow(size_t size, size_t alignment)
+{
+    // At least double, so a growing frame only spills a few times
+    add_block(std::max(size + alignment, std::max(this->total_capacity, size_t(4096))));
+    return allocate(size, alignment);
+}
+
+void
+FrameArena::add_block(size_t size)
+{
+    static_assert(sizeof(Block) <= FRAME_ARENA_HEADER_SIZE, "block header too big");
+
+    Block *block = (Block *) std::malloc(FRAME_ARENA_HEADER_SIZE + size);
+    if (block == nullptr)
+        throw std::bad_alloc();
+
+    if (this->blocks != nullptr)
+        this->spilled += this->head - block_data(this->blocks);
+
+    block->next = this->blocks;
+    block->size = size;
+    this->blocks = block;
+    this->head = block_data(block);
+    this->end = this->head + size;
+    this->total_capacity += size;
+}
+
+void
+FrameArena::free_blocks()
+{
+    while (this->blocks != nullptr)
+    {
+        Block *next = this->blocks->next;
+        std::free(this->blocks);
+        this->blocks = next;
+    }
+    this->head = nullptr;
+    this->end = nullptr;
+    this->total_capacity = 0;
+    this->spilled = 0;
+}
+
+const char *
+FrameArena::format(const char *text, ...)
+{
+    std::va_list args;
+
+    // Usually fits in what is left of the block, formatting once
+    size_t room = this->end - this->head;
+    va_start(args, text);
+    int length = std::vsnprintf((char *) this->head, room, text, args);
+    va_end(args);
+    if (length < 0)
+        return "";
+
+    if (size_t(length) < room)
+        return (const char *) allocate(length + 1, 1);
+
+    char *buffer = (char *) allocate(length + 1, 1);
+    va_start(args, text);
+    std::vsnprintf(buffer, length + 1, text, args);
+    va_end(args);
+    return buffer;
+}
+
+void
+FrameArena::reset()
+{
+    const size_t frame_used = used();
+    this->peak_used = std::max(this->peak_used, frame_used);
+
+    if (this->blocks != nullptr && this->blocks->next != nullptr)
+    {
+        size_t capacity = std::max(this->total_capacity, this->peak_used);
+        free_blocks();
+        add_block(capacity);
+    }
+    else if (this->blocks != nullptr)
+    {
+        this->head = block_data(this->blocks);
+    }
+}
+
+size_t
+FrameArena::used() const
+{
+    if (this->blocks == nullptr)
+        return 0;
+    return this->spilled + (this->head - block_data(this->blocks));
+}
+
+size_t
+FrameArena::capacity() const
+{
+    return this->total_capacity;
+}
+
+size_t
+FrameArena::peak() const
+{
+    return std::max(this->peak_used, used());
+}
+
+void *
+FrameArena::do_allocate(size_t size, size_t alignment)
+{
+    return allocate(size, alignment);
+}
+
+void
+FrameArena::do_deallocate(void *, size_t, size_t) {}
+
+bool
+FrameArena::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
+
+/* Double buffered frame arena */
+
+DoubleFrameArena::DoubleFrameArena(size_t capacity) :
+    first(capacity, false),
+    second(capacity, false),
+    index(0)
+{
+    AddFrameEndCallback(flip_frame_arena, this);
+}
+
+DoubleFrameArena::~DoubleFrameArena()
+{
+    RemoveFrameEndCallback(flip_frame_arena, this);
+}
+
+void
+DoubleFrameArena::flip()
+{
+    this->index ^= 1;
+    current().reset();
+}
+
+FrameArena&
+GetFrameArena()
+{
+    static FrameArena arena;
+    return arena;
+}
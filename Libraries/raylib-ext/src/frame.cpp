@@ -0,0 +1,90 @@
+#include <raylib-ext/frame.hpp>
+#include <raylib-ext/alloc-stats.hpp>
+#include <raylib-ext/profiler.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+struct FrameCallbacks
+{
+    std::mutex mutex;
+    std::vector<std::pair<FrameEndCallback, void *>> callbacks;
+};
+
+// Built on first use, so arenas with static storage can register from
+// their constructors and unregister from their destructors
+static FrameCallbacks &
+frame_callbacks()
+{
+    static FrameCallbacks callbacks;
+    return callbacks;
+}
+
+static std::atomic<uint64_t> frame_count(0);
+
+void
+EndFrame()
+{
+    UpdateAllocStats();
+
+    FrameCallbacks &state = frame_callbacks();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        for (auto [callback, data] : state.callbacks)
+            callback(data);
+    }
+
+    frame_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+AddFrameEndCallback(FrameEndCallback callback, void *data)
+{
+    FrameCallbacks &state = frame_callbacks();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.callbacks.emplace_back(callback, data);
+}
+
+void
+RemoveFrameEndCallback(FrameEndCallback callback, void *data)
+{
+    FrameCallbacks &state = frame_callbacks();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto found = std::find(state.callbacks.begin(), state.callbacks.end(),
+                           std::make_pair(callback, data));
+    if (found != state.callbacks.end())
+        state.callbacks.erase(found);
+}
+
+uint64_t
+GetFrameCount()
+{
+    return frame_count.load(std::memory_order_relaxed);
+}
+
+/* Drawing */
+
+#undef BeginDrawing
+#undef EndDrawing
+
+void
+FrameBeginDrawing()
+{
+    PROFILE_BEGIN("Drawing");
+    BeginDrawing();
+}
+
+// EndDrawing() swaps buffers, polls input and waits for the target FPS
+void
+FrameEndDrawing()
+{
+    PROFILE_BEGIN("EndDrawing");
+    EndDrawing();
+    PROFILE_END();
+    PROFILE_END();
+
+    EndFrame();
+}
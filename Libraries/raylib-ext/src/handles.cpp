@@ -0,0 +1,271 @@
+#include <raylib-ext/handles.hpp>
+
+/* Resource traits */
+
+bool
+ResourceTraits<Image>::valid(const Image &image)
+{
+    return image.data != nullptr;
+}
+
+void
+ResourceTraits<Image>::unload(Image &image)
+{
+    UnloadImage(image);
+    image = Image();
+}
+
+Image
+ResourceTraits<Image>::create(int width, int height, int format)
+{
+    Image image = {};
+    image.data = MemAlloc(GetPixelDataSize(width, height, format));
+    image.width = width;
+    image.height = height;
+    image.mipmaps = 1;
+    image.format = format;
+    return image;
+}
+
+bool
+ResourceTraits<Image>::matches(const Image &image, int width, int height, int format)
+{
+    return image.width == width && image.height == height
+        && image.format == format && image.mipmaps == 1;
+}
+
+bool
+ResourceTraits<Texture2D>::valid(const Texture2D &texture)
+{
+    return texture.id > 0;
+}
+
+void
+ResourceTraits<Texture2D>::unload(Texture2D &texture)
+{
+    UnloadTexture(texture);
+    texture = Texture2D();
+}
+
+bool
+ResourceTraits<RenderTexture2D>::valid(const RenderTexture2D &target)
+{
+    return target.id > 0;
+}
+
+void
+ResourceTraits<RenderTexture2D>::unload(RenderTexture2D &target)
+{
+    UnloadRenderTexture(target);
+    target = RenderTexture2D();
+}
+
+// Compressed formats can't be drawn into; they get RGBA8, and are matched
+// against it so pooled targets are still reused
+static int
+render_texture_format(int format)
+{
+    if (format >= PIXELFORMAT_COMPRESSED_DXT1_RGB)
+        return PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return format;
+}
+
+// LoadRenderTexture() with a color buffer of any uncompressed format
+RenderTexture2D
+ResourceTraits<RenderTexture2D>::create(int width, int height, int format)
+{
+    if (render_texture_format(format) != format)
+        TraceLog(LOG_WARNING, "POOL: Render textures can't be compressed, using RGBA8");
+    format = render_texture_format(format);
+    if (format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
+        return LoadRenderTexture(width, height);
+
+    RenderTexture2D target = {};
+    target.id = rlLoadFramebuffer(width, height);
+    if (target.id == 0)
+        return target;
+
+    rlEnableFramebuffer(target.id);
+    target.texture.id = rlLoadTexture(nullptr, width, height, format, 1);
+    target.texture.width = width;
+    target.texture.height = height;
+    target.texture.format = format;
+    target.texture.mipmaps = 1;
+
+    target.depth.id = rlLoadTextureDepth(width, height, true);
+    target.depth.width = width;
+    target.depth.height = height;
+    target.depth.format = 19;       // DEPTH_COMPONENT_24BIT, as raylib sets it
+    target.depth.mipmaps = 1;
+
+    rlFramebufferAttach(target.id, target.texture.id, RL_ATTACHMENT_COLOR_CHANNEL0,
+                        RL_ATTACHMENT_TEXTURE2D, 0);
+    rlFramebufferAttach(target.id, target.depth.id, RL_ATTACHMENT_DEPTH,
+                        RL_ATTACHMENT_RENDERBUFFER, 0);
+    if (!rlFramebufferComplete(target.id))
+        TraceLog(LOG_WARNING, "POOL: Render texture format %i is not renderable", format);
+    rlDisableFramebuffer();
+
+    return target;
+}
+
+bool
+ResourceTraits<RenderTexture2D>::matches(const RenderTexture2D &target, int width,
+                                         int height, int format)
+{
+    return target.texture.width == width && target.texture.height == height
+        && target.texture.format == render_texture_format(format);
+}
+
+bool
+ResourceTraits<Shader>::valid(const Shader &shader)
+{
+    return shader.id > 0;
+}
+
+void
+ResourceTraits<Shader>::unload(Shader &shader)
+{
+    UnloadShader(shader);   // leaves the default shader alone
+    shader = Shader();
+}
+
+bool
+ResourceTraits<Font>::valid(const Font &font)
+{
+    return font.texture.id > 0;
+}
+
+void
+ResourceTraits<Font>::unload(Font &font)
+{
+    UnloadFont(font);       // leaves the default font alone
+    font = Font();
+}
+
+bool
+ResourceTraits<Sound>::valid(const Sound &sound)
+{
+    return sound.stream.buffer != nullptr;
+}
+
+void
+ResourceTraits<Sound>::unload(Sound &sound)
+{
+    UnloadSound(sound);
+    sound = Sound();
+}
+
+bool
+ResourceTraits<Music>::valid(const Music &music)
+{
+    return music.ctxData != nullptr;
+}
+
+void
+ResourceTraits<Music>::unload(Music &music)
+{
+    UnloadMusicStream(music);
+    music = Music();
+}
+
+bool
+ResourceTraits<Wave>::valid(const Wave &wave)
+{
+    return wave.data != nullptr;
+}
+
+void
+ResourceTraits<Wave>::unload(Wave &wave)
+{
+    UnloadWave(wave);
+    wave = Wave();
+}
+
+bool
+ResourceTraits<Model>::valid(const Model &model)
+{
+    return model.meshes != nullptr || model.materials != nullptr;
+}
+
+void
+ResourceTraits<Model>::unload(Model &model)
+{
+    UnloadModel(model);
+    model = Model();
+}
+
+/* Loaders */
+
+OwnedImage
+LoadImageOwned(const std::string &fileName)
+{
+    return OwnedImage(LoadImage(fileName));
+}
+
+OwnedTexture
+LoadTextureOwned(const std::string &fileName)
+{
+    return OwnedTexture(LoadTexture(fileName));
+}
+
+OwnedTexture
+LoadTextureFromImageOwned(Image image)
+{
+    return OwnedTexture(LoadTextureFromImage(image));
+}
+
+OwnedRenderTexture
+LoadRenderTextureOwned(int width, int height)
+{
+    return OwnedRenderTexture(LoadRenderTexture(width, height));
+}
+
+OwnedShader
+LoadShaderOwned(const std::string &vsFileName, const std::string &fsFileName)
+{
+    return OwnedShader(LoadShader(vsFileName, fsFileName));
+}
+
+OwnedShader
+LoadShaderFromMemoryOwned(const std::string &vsCode, const std::string &fsCode)
+{
+    return OwnedShader(LoadShaderFromMemory(vsCode, fsCode));
+}
+
+OwnedFont
+LoadFontOwned(const std::string &fileName)
+{
+    return OwnedFont(LoadFont(fileName));
+}
+
+OwnedFont
+LoadFontExOwned(const std::string &fileName, int fontSize, int *fontChars,
+                int glyphCount)
+{
+    return OwnedFont(LoadFontEx(fileName, fontSize, fontChars, glyphCount));
+}
+
+OwnedSound
+LoadSoundOwned(const std::string &fileName)
+{
+    return OwnedSound(LoadSound(fileName));
+}
+
+OwnedMusic
+LoadMusicStreamOwned(const std::string &fileName)
+{
+    return OwnedMusic(LoadMusicStream(fileName));
+}
+
+OwnedWave
+LoadWaveOwned(const std::string &fileName)
+{
+    return OwnedWave(LoadWave(fileName));
+}
+
+OwnedModel
+LoadModelOwned(const std::string &fileName)
+{
+    return OwnedModel(LoadModel(fileName));
+}
@@ -0,0 +1,307 @@
+#include <raylib-ext/hot-reload.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+enum WatchKind
+{
+    WATCH_SHADER,
+    WATCH_TEXTURE,
+    WATCH_FONT,
+};
+
+struct WatchEntry
+{
+    WatchKind kind;
+    void *resource;
+    std::string paths[2];
+};
+
+struct HotReload
+{
+    int inotify_fd = -1;
+    int wake_fd = -1;
+    std::thread thread;
+    std::mutex mutex;
+    std::unordered_map<int, std::string> directories;   // watch descriptor -> directory
+    std::set<std::string> changed;
+    std::vector<WatchEntry> entries;
+
+    ~HotReload() { CloseHotReload(); }
+};
+
+static HotReload hot_reload;
+
+static std::string
+normalize_path(const std::string &path)
+{
+    std::error_code error;
+    std::filesystem::path absolute = std::filesystem::absolute(path, error);
+    return (error ? std::filesystem::path(path) : absolute).lexically_normal().string();
+}
+
+#if defined(__linux__)
+
+static void
+watch_loop()
+{
+    alignas(struct inotify_event) char buffer[16384];
+    pollfd fds[2] = {
+        { hot_reload.inotify_fd, POLLIN, 0 },
+        { hot_reload.wake_fd, POLLIN, 0 },
+    };
+
+    for (;;)
+    {
+        if (poll(fds, 2, -1) < 0)
+            continue;
+        if (fds[1].revents & POLLIN)
+            return;
+
+        ssize_t length = read(hot_reload.inotify_fd, buffer, sizeof(buffer));
+        if (length <= 0)
+            continue;
+
+        std::lock_guard<std::mutex> lock(hot_reload.mutex);
+        for (char *p = buffer; p < buffer + length; )
+        {
+            const inotify_event *event = (const inotify_event *) p;
+            auto directory = hot_reload.directories.find(event->wd);
+            if (event->len > 0 && directory != hot_reload.directories.end())
+                hot_reload.changed.insert(directory->second + "/" + event->name);
+            p += sizeof(inotify_event) + event->len;
+        }
+    }
+}
+
+bool
+InitHotReload()
+{
+    if (IsHotReloadReady())
+        return true;
+
+    hot_reload.inotify_fd = inotify_init1(IN_CLOEXEC);
+    hot_reload.wake_fd = eventfd(0, EFD_CLOEXEC);
+    if (hot_reload.inotify_fd < 0 || hot_reload.wake_fd < 0)
+    {
+        TraceLog(LOG_WARNING, "HOT RELOAD: Failed to initialize inotify");
+        CloseHotReload();
+        return false;
+    }
+
+    hot_reload.thread = std::thread(watch_loop);
+    TraceLog(LOG_INFO, "HOT RELOAD: Watcher started");
+    return true;
+}
+
+void
+CloseHotReload()
+{
+    if (hot_reload.thread.joinable())
+    {
+        uint64_t one = 1;
+        if (write(hot_reload.wake_fd, &one, sizeof(one)) == sizeof(one))
+            hot_reload.thread.join();
+        else
+            hot_reload.thread.detach();
+    }
+    if (hot_reload.inotify_fd >= 0)
+        close(hot_reload.inotify_fd);
+    if (hot_reload.wake_fd >= 0)
+        close(hot_reload.wake_fd);
+
+    hot_reload.inotify_fd = -1;
+    hot_reload.wake_fd = -1;
+    hot_reload.directories.clear();
+    hot_reload.changed.clear();
+    hot_reload.entries.clear();
+}
+
+bool
+IsHotReloadReady()
+{
+    return hot_reload.inotify_fd >= 0;
+}
+
+// Watches the directory rather than the file: editors usually save by
+// writing a new file and renaming it over the old one
+static void
+watch_path(const std::string &path)
+{
+    std::string directory = std::filesystem::path(path).parent_path().string();
+    int wd = inotify_add_watch(hot_reload.inotify_fd, directory.c_str(),
+                               IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (wd < 0)
+    {
+        TraceLog(LOG_WARNING, "HOT RELOAD: [%s] Failed to watch directory",
+                 directory.c_str());
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(hot_reload.mutex);
+    hot_reload.directories[wd] = directory;
+}
+
+#else
+
+bool
+InitHotReload()
+{
+    TraceLog(LOG_WARNING, "HOT RELOAD: Not supported on this platform");
+    return false;
+}
+
+void
+CloseHotReload()
+{
+    hot_reload.entries.clear();
+}
+
+bool
+IsHotReloadReady()
+{
+    return false;
+}
+
+static void
+watch_path(const std::string &)
+{
+}
+
+#endif
+
+static void
+add_entry(WatchKind kind, void *resource, const std::string &first,
+          const std::string &second = "")
+{
+    if (!IsHotReloadReady())
+        return;
+
+    UnwatchResource(resource);
+
+    WatchEntry entry = { kind, resource, {} };
+    entry.paths[0] = first.empty() ? "" : normalize_path(first);
+    entry.paths[1] = second.empty() ? "" : normalize_path(second);
+    for (const std::string &path : entry.paths)
+    {
+        if (!path.empty())
+            watch_path(path);
+    }
+    hot_reload.entries.push_back(entry);
+}
+
+void
+WatchShader(Shader *shader, const std::string &vsFileName,
+            const std::string &fsFileName)
+{
+    add_entry(WATCH_SHADER, shader, vsFileName, fsFileName);
+}
+
+void
+WatchTexture(Texture2D *texture, const std::string &fileName)
+{
+    add_entry(WATCH_TEXTURE, texture, fileName);
+}
+
+void
+WatchFont(Font *font, const std::string &fileName)
+{
+    add_entry(WATCH_FONT, font, fileName);
+}
+
+void
+UnwatchResource(const void *resource)
+{
+    auto &entries = hot_reload.entries;
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+        [resource](const WatchEntry &entry) { return entry.resource == resource; }),
+        entries.end());
+}
+
+static bool
+reload(const WatchEntry &entry)
+{
+    const char *first = entry.paths[0].empty() ? nullptr : entry.paths[0].c_str();
+    const char *second = entry.paths[1].empty() ? nullptr : entry.paths[1].c_str();
+
+    switch (entry.kind)
+    {
+    case WATCH_SHADER:
+    {
+        Shader *shader = (Shader *) entry.resource;
+        Shader fresh = LoadShader(first, second);
+        if (fresh.id == 0 || fresh.id == rlGetShaderIdDefault())
+        {
+            TraceLog(LOG_WARNING, "HOT RELOAD: Shader failed to build, keeping previous program");
+            return false;
+        }
+        UnloadShader(*shader);
+        *shader = fresh;
+        return true;
+    }
+    case WATCH_TEXTURE:
+    {
+        Texture2D *texture = (Texture2D *) entry.resource;
+        Texture2D fresh = LoadTexture(first);
+        if (fresh.id == 0)
+            return false;
+        if (texture->mipmaps > 1)
+            GenTextureMipmaps(&fresh);
+        UnloadTexture(*texture);
+        *texture = fresh;
+        return true;
+    }
+    case WATCH_FONT:
+    {
+        Font *font = (Font *) entry.resource;
+        Font fresh = IsFileExtension(first, ".ttf;.otf")
+                   ? LoadFontEx(first, font->baseSize, nullptr, font->glyphCount)
+                   : LoadFont(first);
+        if (fresh.texture.id == 0 || fresh.texture.id == GetFontDefault().texture.id)
+            return false;
+        UnloadFont(*font);
+        *font = fresh;
+        return true;
+    }
+    }
+    return false;
+}
+
+int
+UpdateHotReload()
+{
+    std::set<std::string> changed;
+    {
+        std::lock_guard<std::mutex> lock(hot_reload.mutex);
+        if (hot_reload.changed.empty())
+            return 0;
+        changed.swap(hot_reload.changed);
+    }
+
+    int reloaded = 0;
+    for (const WatchEntry &entry : hot_reload.entries)
+    {
+        bool touched = changed.count(entry.paths[0]) > 0
+                    || changed.count(entry.paths[1]) > 0;
+        if (touched && reload(entry))
+        {
+            TraceLog(LOG_INFO, "HOT RELOAD: [%s] Reloaded", entry.paths[0].empty()
+                     ? entry.paths[1].c_str() : entry.paths[0].c_str());
+            ++reloaded;
+        }
+    }
+    return reloaded;
+}
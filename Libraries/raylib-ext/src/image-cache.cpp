@@ -0,0 +1,200 @@
+#include <raylib-ext/image-cache.hpp>
+#include <raylib-ext/profiler.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#define IMAGE_CACHE_MAGIC   0x43494c52  // "RLIC"
+#define IMAGE_CACHE_VERSION 1
+#define IMAGE_CACHE_EXT     ".rlcache"
+
+struct ImageCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t path_hash;
+    int64_t mod_time;
+    int64_t file_size;
+    int32_t width;
+    int32_t height;
+    int32_t format;
+    int32_t mipmaps;
+    uint64_t data_size;
+    uint8_t reserved[8];
+};
+
+// Pixel data starts right after the header, 64-byte aligned
+static_assert(sizeof(ImageCacheHeader) == 64, "ImageCacheHeader must be 64 bytes");
+
+static uint64_t
+hash_path(const std::string &path)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : path)
+    {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static uint64_t
+image_data_size(int width, int height, int format, int mipmaps)
+{
+    uint64_t size = 0;
+    for (int i = 0; i < mipmaps; ++i)
+    {
+        size += GetPixelDataSize(width, height, format);
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    return size;
+}
+
+static bool
+read_header(std::FILE *file, const std::string &fileName, bool mipmaps,
+            ImageCacheHeader &header)
+{
+    if (std::fread(&header, sizeof(header), 1, file) != 1)
+        return false;
+
+    return header.magic == IMAGE_CACHE_MAGIC
+        && header.version == IMAGE_CACHE_VERSION
+        && header.path_hash == hash_path(fileName)
+        && header.mod_time == GetFileModTime(fileName)
+        && header.file_size == GetFileLength(fileName.c_str())
+        && (header.mipmaps > 1) == mipmaps
+        && header.width > 0 && header.height > 0 && header.mipmaps > 0
+        && header.data_size == image_data_size(header.width, header.height,
+                                               header.format, header.mipmaps);
+}
+
+std::string
+GetImageCachePath(const std::string &fileName)
+{
+    return fileName + IMAGE_CACHE_EXT;
+}
+
+bool
+IsImageCacheValid(const std::string &fileName, bool mipmaps)
+{
+    std::FILE *file = std::fopen(GetImageCachePath(fileName).c_str(), "rb");
+    if (file == nullptr)
+        return false;
+
+    ImageCacheHeader header;
+    bool valid = read_header(file, fileName, mipmaps, header);
+    std::fclose(file);
+    return valid;
+}
+
+bool
+ExportImageCache(Image image, const std::string &fileName)
+{
+    if (image.data == nullptr || !FileExists(fileName))
+        return false;
+
+    ImageCacheHeader header = {};
+    header.magic = IMAGE_CACHE_MAGIC;
+    header.version = IMAGE_CACHE_VERSION;
+    header.path_hash = hash_path(fileName);
+    header.mod_time = GetFileModTime(fileName);
+    header.file_size = GetFileLength(fileName.c_str());
+    header.width = image.width;
+    header.height = image.height;
+    header.format = image.format;
+    header.mipmaps = image.mipmaps;
+    header.data_size = image_data_size(image.width, image.height,
+                                       image.format, image.mipmaps);
+
+    // Write to a temporary file first, so a concurrent reader never sees
+    // a half-written cache
+    std::string cache_path = GetImageCachePath(fileName);
+    std::string temp_path = cache_path + ".tmp";
+    std::FILE *file = std::fopen(temp_path.c_str(), "wb");
+    if (file == nullptr)
+    {
+        TraceLog(LOG_WARNING, "IMAGE CACHE: [%s] Failed to create cache file",
+                 cache_path.c_str());
+        return false;
+    }
+
+    bool written = std::fwrite(&header, sizeof(header), 1, file) == 1
+        && std::fwrite(image.data, 1, header.data_size, file) == header.data_size;
+    written = std::fclose(file) == 0 && written;
+
+    std::remove(cache_path.c_str());
+    if (!written || std::rename(temp_path.c_str(), cache_path.c_str()) != 0)
+    {
+        TraceLog(LOG_WARNING, "IMAGE CACHE: [%s] Failed to write cache file",
+                 cache_path.c_str());
+        std::remove(temp_path.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool
+DeleteImageCache(const std::string &fileName)
+{
+    return std::remove(GetImageCachePath(fileName).c_str()) == 0;
+}
+
+Image
+LoadImageCached(const std::string &fileName, bool mipmaps)
+{
+    PROFILE_FUNCTION();
+    Image image = {};
+
+    std::FILE *file = std::fopen(GetImageCachePath(fileName).c_str(), "rb");
+    if (file != nullptr)
+    {
+        ImageCacheHeader header;
+        if (read_header(file, fileName, mipmaps, header))
+        {
+            image.data = MemAlloc(int(header.data_size));
+            if (std::fread(image.data, 1, header.data_size, file) == header.data_size)
+            {
+                image.width = header.width;
+                image.height = header.height;
+                image.format = header.format;
+                image.mipmaps = header.mipmaps;
+            }
+            else
+            {
+                MemFree(image.data);
+                image.data = nullptr;
+            }
+        }
+        std::fclose(file);
+
+        if (image.data != nullptr)
+            return image;
+    }
+
+    image = LoadImage(fileName);
+    if (image.data == nullptr)
+        return image;
+
+    if (mipmaps && image.mipmaps == 1)
+        ImageMipmaps(&image);
+    ExportImageCache(image, fileName);
+
+    return image;
+}
+
+Texture2D
+LoadTextureCached(const std::string &fileName, bool mipmaps)
+{
+    PROFILE_FUNCTION();
+    Texture2D texture = {};
+    Image image = LoadImageCached(fileName, mipmaps);
+    if (image.data != nullptr)
+    {
+        texture = LoadTextureFromImage(image);
+        UnloadImage(image);
+    }
+    return texture;
+}
@@ -0,0 +1,710 @@
+#include <raylib-ext/image-export.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#define DEFLATE_WINDOW_SIZE 32768
+#define DEFLATE_WINDOW_MASK (DEFLATE_WINDOW_SIZE - 1)
+#define DEFLATE_HASH_BITS   15
+#define DEFLATE_MIN_MATCH   3
+#define DEFLATE_MAX_MATCH   258
+#define DEFLATE_MAX_CHAIN   16
+
+#define ADLER_BASE 65521
+#define ADLER_NMAX 5552
+
+#define QOI_OP_INDEX 0x00
+#define QOI_OP_DIFF  0x40
+#define QOI_OP_LUMA  0x80
+#define QOI_OP_RUN   0xc0
+#define QOI_OP_RGB   0xfe
+#define QOI_OP_RGBA  0xff
+
+typedef std::vector<unsigned char> Bytes;
+
+/* Helpers */
+
+struct PixelData
+{
+    const unsigned char *data;
+    int width;
+    int height;
+    int channels;
+    Image converted;    // owned copy when the source had to be converted
+
+    size_t stride() const { return size_t(width) * channels; }
+    const unsigned char *row(int y) const { return data + y * stride(); }
+};
+
+static bool
+load_pixels(Image image, bool allow_gray, PixelData &pixels)
+{
+    pixels.converted = {};
+    pixels.data = (const unsigned char *) image.data;
+    pixels.width = image.width;
+    pixels.height = image.height;
+
+    switch (image.format)
+    {
+    case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE: pixels.channels = 1; break;
+    case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA: pixels.channels = 2; break;
+    case PIXELFORMAT_UNCOMPRESSED_R8G8B8: pixels.channels = 3; break;
+    case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8: pixels.channels = 4; break;
+    default: pixels.channels = 0; break;
+    }
+
+    if (pixels.channels == 0 || (pixels.channels < 3 && !allow_gray))
+    {
+        if (image.format >= PIXELFORMAT_COMPRESSED_DXT1_RGB)
+            return false;
+
+        pixels.converted = ImageCopy(image);
+        pixels.converted.mipmaps = 1;
+        ImageFormat(&pixels.converted, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        pixels.data = (const unsigned char *) pixels.converted.data;
+        pixels.channels = 4;
+    }
+
+    return pixels.data != nullptr;
+}
+
+// Splits [0, height) into row strips, several per thread for load balance
+static std::vector<int>
+split_rows(int height, int threads)
+{
+    int strips = std::max(1, std::min(height, threads * 4));
+    std::vector<int> bounds(strips + 1);
+    for (int i = 0; i <= strips; ++i)
+        bounds[i] = int(int64_t(height) * i / strips);
+    return bounds;
+}
+
+template <typename F>
+static void
+run_parallel(int tasks, int threads, F task)
+{
+    threads = std::min(threads, tasks);
+    std::atomic<int> next(0);
+    auto worker = [&] {
+        for (int i = next++; i < tasks; i = next++)
+            task(i);
+    };
+
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; ++i)
+        pool.emplace_back(worker);
+    worker();
+    for (std::thread &thread : pool)
+        thread.join();
+}
+
+static void
+put_u32_be(Bytes &out, uint32_t value)
+{
+    out.push_back(uint8_t(value >> 24));
+    out.push_back(uint8_t(value >> 16));
+    out.push_back(uint8_t(value >> 8));
+    out.push_back(uint8_t(value));
+}
+
+static bool
+write_parts(const std::string &fileName, const std::vector<Bytes> &parts)
+{
+    std::FILE *file = std::fopen(fileName.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    bool written = true;
+    for (const Bytes &part : parts)
+    {
+        if (!part.empty())
+            written = written && std::fwrite(part.data(), 1, part.size(), file) == part.size();
+    }
+    return std::fclose(file) == 0 && written;
+}
+
+/* Checksums */
+
+static const uint32_t *
+crc_table()
+{
+    static const struct Table
+    {
+        uint32_t values[256];
+        Table()
+        {
+            for (uint32_t n = 0; n < 256; ++n)
+            {
+                uint32_t c = n;
+                for (int k = 0; k < 8; ++k)
+                    c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+                values[n] = c;
+            }
+        }
+    } table;
+    return table.values;
+}
+
+static uint32_t
+crc32_update(uint32_t crc, const unsigned char *data, size_t size)
+{
+    const uint32_t *table = crc_table();
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i)
+        crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    return ~crc;
+}
+
+static uint32_t
+adler32(const unsigned char *data, size_t size)
+{
+    uint32_t a = 1, b = 0;
+    while (size > 0)
+    {
+        size_t block = std::min(size, size_t(ADLER_NMAX));
+        size -= block;
+        while (block--)
+        {
+            a += *data++;
+            b += a;
+        }
+        a %= ADLER_BASE;
+        b %= ADLER_BASE;
+    }
+    return (b << 16) | a;
+}
+
+// Same as zlib's adler32_combine(): checksum of A+B from checksums of A and B
+static uint32_t
+adler32_combine(uint32_t adler1, uint32_t adler2, size_t size2)
+{
+    uint32_t rem = uint32_t(size2 % ADLER_BASE);
+    uint32_t sum1 = adler1 & 0xffff;
+    uint32_t sum2 = uint32_t((uint64_t(rem) * sum1) % ADLER_BASE);
+    sum1 += (adler2 & 0xffff) + ADLER_BASE - 1;
+    sum2 += (adler1 >> 16) + (adler2 >> 16) + ADLER_BASE - rem;
+    if (sum1 >= ADLER_BASE) sum1 -= ADLER_BASE;
+    if (sum1 >= ADLER_BASE) sum1 -= ADLER_BASE;
+    if (sum2 >= 2 * ADLER_BASE) sum2 -= 2 * ADLER_BASE;
+    if (sum2 >= ADLER_BASE) sum2 -= ADLER_BASE;
+    return sum1 | (sum2 << 16);
+}
+
+/* Deflate */
+
+// Strips are compressed independently with fixed Huffman codes and end in
+// a sync flush (an empty stored block), so their outputs can simply be
+// concatenated into one deflate stream.
+
+static const uint16_t LENGTH_BASE[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t LENGTH_EXTRA[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t DISTANCE_BASE[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385,
+    513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t DISTANCE_EXTRA[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+struct FixedHuffman
+{
+    uint16_t literal_code[288];
+    uint8_t literal_bits[288];
+    uint8_t distance_code[30];
+    uint8_t length_symbol[DEFLATE_MAX_MATCH + 1];
+
+    FixedHuffman()
+    {
+        for (int i = 0; i < 288; ++i)
+        {
+            uint32_t code;
+            int bits;
+            if (i < 144)      { code = 0x30 + i;          bits = 8; }
+            else if (i < 256) { code = 0x190 + (i - 144); bits = 9; }
+            else if (i < 280) { code = i - 256;           bits = 7; }
+            else              { code = 0xc0 + (i - 280);  bits = 8; }
+            literal_code[i] = uint16_t(reverse(code, bits));
+            literal_bits[i] = uint8_t(bits);
+        }
+        for (int i = 0; i < 30; ++i)
+            distance_code[i] = uint8_t(reverse(i, 5));
+        for (int symbol = 0; symbol < 29; ++symbol)
+        {
+            int end = std::min(LENGTH_BASE[symbol] + (1 << LENGTH_EXTRA[symbol]),
+                               DEFLATE_MAX_MATCH + 1);
+            for (int length = LENGTH_BASE[symbol]; length < end; ++length)
+                length_symbol[length] = uint8_t(symbol);
+        }
+    }
+
+    static uint32_t reverse(uint32_t code, int bits)
+    {
+        uint32_t result = 0;
+        for (int i = 0; i < bits; ++i, code >>= 1)
+            result = (result << 1) | (code & 1);
+        return result;
+    }
+};
+
+struct BitWriter
+{
+    Bytes &out;
+    uint64_t bits;
+    int count;
+
+    BitWriter(Bytes &out) : out(out), bits(0), count(0) {}
+
+    void put(uint32_t value, int length)
+    {
+        bits |= uint64_t(value) << count;
+        count += length;
+        while (count >= 8)
+        {
+            out.push_back(uint8_t(bits));
+            bits >>= 8;
+            count -= 8;
+        }
+    }
+
+    void align()
+    {
+        if (count > 0)
+            out.push_back(uint8_t(bits));
+        bits = 0;
+        count = 0;
+    }
+};
+
+static void
+deflate_strip(const unsigned char *data, size_t size, Bytes &out)
+{
+    static const FixedHuffman huffman;
+
+    BitWriter writer(out);
+    writer.put(0, 1);   // BFINAL
+    writer.put(1, 2);   // BTYPE: fixed Huffman
+
+    std::vector<int32_t> head(1 << DEFLATE_HASH_BITS, -1);
+    std::vector<int32_t> prev(DEFLATE_WINDOW_SIZE, -1);
+    auto hash = [data](size_t pos) {
+        uint32_t v = data[pos] | (data[pos + 1] << 8) | (data[pos + 2] << 16);
+        return (v * 2654435761u) >> (32 - DEFLATE_HASH_BITS);
+    };
+    auto insert = [&](size_t pos) {
+        uint32_t h = hash(pos);
+        int32_t candidate = head[h];
+        prev[pos & DEFLATE_WINDOW_MASK] = candidate;
+        head[h] = int32_t(pos);
+        return candidate;
+    };
+
+    size_t pos = 0;
+    while (pos < size)
+    {
+        size_t best_length = 0;
+        size_t best_distance = 0;
+        if (pos + DEFLATE_MIN_MATCH <= size)
+        {
+            size_t max_length = std::min(size_t(DEFLATE_MAX_MATCH), size - pos);
+            int32_t candidate = insert(pos);
+            for (int chain = DEFLATE_MAX_CHAIN;
+                 candidate >= 0 && pos - candidate < DEFLATE_WINDOW_SIZE && chain > 0;
+                 --chain)
+            {
+                const unsigned char *a = data + candidate;
+                const unsigned char *b = data + pos;
+                if (a[best_length] == b[best_length])
+                {
+                    size_t length = 0;
+                    while (length < max_length && a[length] == b[length])
+                        ++length;
+                    if (length > best_length)
+                    {
+                        best_length = length;
+                        best_distance = pos - candidate;
+                        if (length == max_length)
+                            break;
+                    }
+                }
+
+                int32_t next = prev[candidate & DEFLATE_WINDOW_MASK];
+                if (next >= candidate)
+                    break;
+                candidate = next;
+            }
+        }
+
+        if (best_length >= DEFLATE_MIN_MATCH)
+        {
+            int symbol = huffman.length_symbol[best_length];
+            writer.put(huffman.literal_code[257 + symbol], huffman.literal_bits[257 + symbol]);
+            if (LENGTH_EXTRA[symbol] > 0)
+                writer.put(uint32_t(best_length - LENGTH_BASE[symbol]), LENGTH_EXTRA[symbol]);
+
+            int distance = int(std::upper_bound(DISTANCE_BASE, DISTANCE_BASE + 30,
+                                                best_distance) - DISTANCE_BASE) - 1;
+            writer.put(huffman.distance_code[distance], 5);
+            if (DISTANCE_EXTRA[distance] > 0)
+                writer.put(uint32_t(best_distance - DISTANCE_BASE[distance]),
+                           DISTANCE_EXTRA[distance]);
+
+            size_t end = pos + best_length;
+            for (++pos; pos < end; ++pos)
+            {
+                if (pos + DEFLATE_MIN_MATCH <= size)
+                    insert(pos);
+            }
+        }
+        else
+        {
+            writer.put(huffman.literal_code[data[pos]], huffman.literal_bits[data[pos]]);
+            ++pos;
+        }
+    }
+    writer.put(huffman.literal_code[256], huffman.literal_bits[256]);
+
+    // Sync flush: empty non-final stored block, leaves the stream byte aligned
+    writer.put(0, 3);
+    writer.align();
+    out.insert(out.end(), { 0x00, 0x00, 0xff, 0xff });
+}
+
+/* PNG */
+
+static int
+paeth(int a, int b, int c)
+{
+    int p = a + b - c;
+    int pa = std::abs(p - a);
+    int pb = std::abs(p - b);
+    int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) return a;
+    if (pb <= pc) return b;
+    return c;
+}
+
+// Writes the filter byte and filtered row, picking the filter with the
+// smallest sum of absolute differences (the usual libpng heuristic)
+static void
+filter_row(const unsigned char *row, const unsigned char *prior, size_t size,
+           int bpp, unsigned char *out, unsigned char *scratch)
+{
+    size_t best_sum = SIZE_MAX;
+    for (int filter = 0; filter < 5; ++filter)
+    {
+        unsigned char *dst = filter == 0 ? out + 1 : scratch;
+        size_t sum = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            int a = i >= size_t(bpp) ? row[i - bpp] : 0;
+            int b = prior != nullptr ? prior[i] : 0;
+            int c = i >= size_t(bpp) && prior != nullptr ? prior[i - bpp] : 0;
+            int predicted = 0;
+            switch (filter)
+            {
+            case 1: predicted = a; break;
+            case 2: predicted = b; break;
+            case 3: predicted = (a + b) / 2; break;
+            case 4: predicted = paeth(a, b, c); break;
+            }
+            dst[i] = uint8_t(row[i] - predicted);
+            sum += std::abs(int(int8_t(dst[i])));
+        }
+
+        if (sum < best_sum)
+        {
+            best_sum = sum;
+            out[0] = uint8_t(filter);
+            if (filter != 0)
+                std::copy(scratch, scratch + size, out + 1);
+        }
+    }
+}
+
+static void
+append_chunk(Bytes &out, const char *type, const unsigned char *data, size_t size)
+{
+    put_u32_be(out, uint32_t(size));
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data, data + size);
+    put_u32_be(out, crc32_update(0, out.data() + start, size + 4));
+}
+
+static bool
+export_png(const PixelData &pixels, const std::string &fileName, int threads)
+{
+    static const uint8_t color_types[5] = { 0, 0, 4, 2, 6 };
+    std::vector<int> bounds = split_rows(pixels.height, threads);
+    int strips = int(bounds.size()) - 1;
+
+    // parts: header, one IDAT chunk per strip, trailer
+    std::vector<Bytes> parts(strips + 2);
+    std::vector<uint32_t> adlers(strips);
+    std::vector<size_t> sizes(strips);
+
+    run_parallel(strips, threads, [&](int strip) {
+        size_t stride = pixels.stride();
+        int rows = bounds[strip + 1] - bounds[strip];
+        Bytes filtered((stride + 1) * rows);
+        Bytes scratch(stride);
+        for (int r = 0; r < rows; ++r)
+        {
+            int y = bounds[strip] + r;
+            filter_row(pixels.row(y), y > 0 ? pixels.row(y - 1) : nullptr,
+                       stride, pixels.channels,
+                       filtered.data() + r * (stride + 1), scratch.data());
+        }
+        adlers[strip] = adler32(filtered.data(), filtered.size());
+        sizes[strip] = filtered.size();
+
+        Bytes compressed;
+        compressed.reserve(filtered.size() / 2);
+        deflate_strip(filtered.data(), filtered.size(), compressed);
+
+        Bytes &chunk = parts[strip + 1];
+        chunk.reserve(compressed.size() + 12);
+        append_chunk(chunk, "IDAT", compressed.data(), compressed.size());
+    });
+
+    Bytes &header = parts.front();
+    const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+    header.insert(header.end(), signature, signature + 8);
+
+    Bytes ihdr;
+    put_u32_be(ihdr, uint32_t(pixels.width));
+    put_u32_be(ihdr, uint32_t(pixels.height));
+    ihdr.insert(ihdr.end(), { 8, color_types[pixels.channels], 0, 0, 0 });
+    append_chunk(header, "IHDR", ihdr.data(), ihdr.size());
+
+    const unsigned char zlib_header[2] = { 0x78, 0x01 };
+    append_chunk(header, "IDAT", zlib_header, 2);
+
+    uint32_t adler = adlers[0];
+    for (int i = 1; i < strips; ++i)
+        adler = adler32_combine(adler, adlers[i], sizes[i]);
+
+    Bytes &trailer = parts.back();
+    Bytes end_of_stream = { 0x03, 0x00 };   // empty final fixed Huffman block
+    put_u32_be(end_of_stream, adler);
+    append_chunk(trailer, "IDAT", end_of_stream.data(), end_of_stream.size());
+    append_chunk(trailer, "IEND", nullptr, 0);
+
+    return write_parts(fileName, parts);
+}
+
+/* QOI */
+
+// QOI is a sequential format, but a strip can be encoded independently
+// as long as it starts from the last pixel of the previous strip, never
+// continues a run across the boundary, and only emits QOI_OP_INDEX for
+// slots it has filled itself (the decoder holds the same value there).
+
+struct QoiPixel
+{
+    uint8_t r, g, b, a;
+    bool operator==(const QoiPixel &p) const
+    {
+        return r == p.r && g == p.g && b == p.b && a == p.a;
+    }
+};
+
+static void
+qoi_encode_strip(const PixelData &pixels, size_t first, size_t last, Bytes &out)
+{
+    QoiPixel index[64] = {};
+    bool valid[64] = {};
+    const unsigned char *data = pixels.data;
+    int channels = pixels.channels;
+
+    auto load = [&](size_t i) {
+        const unsigned char *p = data + i * channels;
+        return QoiPixel { p[0], p[1], p[2], channels == 4 ? p[3] : uint8_t(255) };
+    };
+
+    QoiPixel prev = first > 0 ? load(first - 1) : QoiPixel { 0, 0, 0, 255 };
+    int run = 0;
+    for (size_t i = first; i < last; ++i)
+    {
+        QoiPixel px = load(i);
+        if (px == prev)
+        {
+            if (++run == 62)
+            {
+                out.push_back(uint8_t(QOI_OP_RUN | (run - 1)));
+                run = 0;
+            }
+            continue;
+        }
+
+        if (run > 0)
+        {
+            out.push_back(uint8_t(QOI_OP_RUN | (run - 1)));
+            run = 0;
+        }
+
+        int slot = (px.r * 3 + px.g * 5 + px.b * 7 + px.a * 11) % 64;
+        if (valid[slot] && index[slot] == px)
+        {
+            out.push_back(uint8_t(QOI_OP_INDEX | slot));
+        }
+        else
+        {
+            index[slot] = px;
+            valid[slot] = true;
+
+            if (px.a == prev.a)
+            {
+                int8_t vr = int8_t(px.r - prev.r);
+                int8_t vg = int8_t(px.g - prev.g);
+                int8_t vb = int8_t(px.b - prev.b);
+                int8_t vg_r = int8_t(vr - vg);
+                int8_t vg_b = int8_t(vb - vg);
+
+                if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2)
+                {
+                    out.push_back(uint8_t(QOI_OP_DIFF | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2)));
+                }
+                else if (vg_r > -9 && vg_r < 8 && vg > -33 && vg < 32 && vg_b > -9 && vg_b < 8)
+                {
+                    out.push_back(uint8_t(QOI_OP_LUMA | (vg + 32)));
+                    out.push_back(uint8_t((vg_r + 8) << 4 | (vg_b + 8)));
+                }
+                else
+                {
+                    out.insert(out.end(), { QOI_OP_RGB, px.r, px.g, px.b });
+                }
+            }
+            else
+            {
+                out.insert(out.end(), { QOI_OP_RGBA, px.r, px.g, px.b, px.a });
+            }
+        }
+        prev = px;
+    }
+
+    if (run > 0)
+        out.push_back(uint8_t(QOI_OP_RUN | (run - 1)));
+}
+
+static bool
+export_qoi(const PixelData &pixels, const std::string &fileName, int threads)
+{
+    std::vector<int> bounds = split_rows(pixels.height, threads);
+    int strips = int(bounds.size()) - 1;
+    std::vector<Bytes> parts(strips + 2);
+
+    run_parallel(strips, threads, [&](int strip) {
+        size_t first = size_t(bounds[strip]) * pixels.width;
+        size_t last = size_t(bounds[strip + 1]) * pixels.width;
+        parts[strip + 1].reserve((last - first) * 2);
+        qoi_encode_strip(pixels, first, last, parts[strip + 1]);
+    });
+
+    Bytes &header = parts.front();
+    header.insert(header.end(), { 'q', 'o', 'i', 'f' });
+    put_u32_be(header, uint32_t(pixels.width));
+    put_u32_be(header, uint32_t(pixels.height));
+    header.insert(header.end(), { uint8_t(pixels.channels), 0 });
+
+    parts.back() = { 0, 0, 0, 0, 0, 0, 0, 1 };
+
+    return write_parts(fileName, parts);
+}
+
+/* PPM / raw */
+
+static bool
+export_ppm(const PixelData &pixels, const std::string &fileName, int threads)
+{
+    std::vector<int> bounds = split_rows(pixels.height, threads);
+    int strips = int(bounds.size()) - 1;
+    std::vector<Bytes> parts(strips + 1);
+
+    std::string header = "P6\n" + std::to_string(pixels.width) + " "
+                       + std::to_string(pixels.height) + "\n255\n";
+    parts[0].assign(header.begin(), header.end());
+
+    run_parallel(strips, threads, [&](int strip) {
+        size_t first = size_t(bounds[strip]) * pixels.width;
+        size_t last = size_t(bounds[strip + 1]) * pixels.width;
+        Bytes &rgb = parts[strip + 1];
+        rgb.resize((last - first) * 3);
+        const unsigned char *src = pixels.data + first * pixels.channels;
+        for (size_t i = 0; i < last - first; ++i, src += pixels.channels)
+        {
+            rgb[i * 3 + 0] = src[0];
+            rgb[i * 3 + 1] = src[1];
+            rgb[i * 3 + 2] = src[2];
+        }
+    });
+
+    return write_parts(fileName, parts);
+}
+
+static bool
+export_raw(const PixelData &pixels, const std::string &fileName)
+{
+    std::FILE *file = std::fopen(fileName.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    size_t size = pixels.stride() * pixels.height;
+    bool written = std::fwrite(pixels.data, 1, size, file) == size;
+    return std::fclose(file) == 0 && written;
+}
+
+bool
+ExportImageParallel(Image image, const std::string &fileName, int threads)
+{
+    if (image.data == nullptr || image.width <= 0 || image.height <= 0)
+        return false;
+
+    if (threads <= 0)
+        threads = std::max(1, int(std::thread::hardware_concurrency()));
+
+    bool png = IsFileExtension(fileName, ".png");
+    bool qoi = IsFileExtension(fileName, ".qoi");
+    bool ppm = IsFileExtension(fileName, ".ppm");
+    bool raw = IsFileExtension(fileName, ".raw");
+    if (!png && !qoi && !ppm && !raw)
+    {
+        TraceLog(LOG_WARNING, "IMAGE: [%s] Export format not supported, "
+                 "falling back to ExportImage()", fileName.c_str());
+        return ExportImage(image, fileName);
+    }
+
+    PixelData pixels;
+    if (!load_pixels(image, png || raw, pixels))
+    {
+        TraceLog(LOG_WARNING, "IMAGE: [%s] Pixel format not supported for export",
+                 fileName.c_str());
+        return false;
+    }
+
+    bool success = false;
+    if (png) success = export_png(pixels, fileName, threads);
+    else if (qoi) success = export_qoi(pixels, fileName, threads);
+    else if (ppm) success = export_ppm(pixels, fileName, threads);
+    else success = export_raw(pixels, fileName);
+
+    if (pixels.converted.data != nullptr)
+        UnloadImage(pixels.converted);
+
+    if (success) TraceLog(LOG_INFO, "FILEIO: [%s] Image exported successfully", fileName.c_str());
+    else TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to export image", fileName.c_str());
+
+    return success;
+}
@@ -0,0 +1,415 @@
+#include <raylib-ext/instancing.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "stream.hpp"
+
+// Past raylib's fixed attribute locations (position..texcoord2 = 0..5)
+#define INSTANCE_LOCATION_POSITION  6
+#define INSTANCE_LOCATION_SCALE     7
+#define INSTANCE_LOCATION_ROTATION  8
+#define INSTANCE_LOCATION_COLOR     9
+#define INSTANCE_LOCATION_TRANSFORM 6   // mat4, 6..9
+#define INSTANCE_LOCATION_TINT      10
+
+static const char *shape_vs = R"(#version 330
+layout(location = 0) in vec2 vertexPosition;
+layout(location = 6) in vec2 instancePosition;
+layout(location = 7) in vec2 instanceScale;
+layout(location = 8) in float instanceRotation;
+layout(location = 9) in vec4 instanceColor;
+uniform mat4 mvp;
+out vec4 fragColor;
+void main()
+{
+    float angle = radians(instanceRotation);
+    float s = sin(angle);
+    float c = cos(angle);
+    vec2 p = vertexPosition*instanceScale;
+    p = vec2(p.x*c - p.y*s, p.x*s + p.y*c) + instancePosition;
+    fragColor = instanceColor;
+    gl_Position = mvp*vec4(p, 0.0, 1.0);
+}
+)";
+
+static const char *shape_fs = R"(#version 330
+in vec4 fragColor;
+out vec4 finalColor;
+void main()
+{
+    finalColor = fragColor;
+}
+)";
+
+static const char *mesh_vs = R"(#version 330
+layout(location = 0) in vec3 vertexPosition;
+layout(location = 1) in vec2 vertexTexCoord;
+layout(location = 6) in mat4 instanceTransform;
+layout(location = 10) in vec4 instanceColor;
+uniform mat4 mvp;
+out vec2 fragTexCoord;
+out vec4 fragColor;
+void main()
+{
+    fragTexCoord = vertexTexCoord;
+    fragColor = instanceColor;
+    gl_Position = mvp*instanceTransform*vec4(vertexPosition, 1.0);
+}
+)";
+
+static const char *mesh_fs = R"(#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+out vec4 finalColor;
+void main()
+{
+    finalColor = texture(texture0, fragTexCoord)*colDiffuse*fragColor;
+}
+)";
+
+struct ShapeGeometry
+{
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    std::vector<Vector2> vertices;
+};
+
+struct MeshInstance
+{
+    float16 transform;
+    Color color;
+};
+
+struct Instancing
+{
+    bool initialized = false;
+    bool supported = false;
+    bool forced_fallback = false;
+
+    GLuint shape_program = 0;
+    GLint shape_mvp = -1;
+    GLuint mesh_program = 0;
+    GLint mesh_mvp = -1;
+    GLint mesh_color = -1;
+    GLint mesh_texture = -1;
+
+    GLuint instance_vbo = 0;
+    size_t instance_capacity = 0;
+
+    std::map<int, ShapeGeometry> circles;
+    ShapeGeometry quad;
+    std::vector<MeshInstance> mesh_instances;
+};
+
+static Instancing instancing;
+
+static GLuint
+load_program(const char *vs, const char *fs)
+{
+    // rlLoadShaderCode() falls back to the default shader when anything fails
+    GLuint program = rlLoadShaderCode(vs, fs);
+    return program != rlGetShaderIdDefault() ? program : 0;
+}
+
+static void
+init_instancing()
+{
+    instancing.initialized = true;
+
+    if (glad_glDrawArraysInstanced == nullptr || glad_glVertexAttribDivisor == nullptr)
+    {
+        TraceLog(LOG_WARNING, "INSTANCING: Instanced drawing not available, using CPU fallback");
+        return;
+    }
+
+    instancing.shape_program = load_program(shape_vs, shape_fs);
+    instancing.mesh_program = load_program(mesh_vs, mesh_fs);
+    if (instancing.shape_program == 0 || instancing.mesh_program == 0)
+    {
+        TraceLog(LOG_WARNING, "INSTANCING: Failed to build instancing shaders, using CPU fallback");
+        return;
+    }
+
+    instancing.shape_mvp = glGetUniformLocation(instancing.shape_program, "mvp");
+    instancing.mesh_mvp = glGetUniformLocation(instancing.mesh_program, "mvp");
+    instancing.mesh_color = glGetUniformLocation(instancing.mesh_program, "colDiffuse");
+    instancing.mesh_texture = glGetUniformLocation(instancing.mesh_program, "texture0");
+
+    glGenBuffers(1, &instancing.instance_vbo);
+    instancing.supported = true;
+}
+
+static bool
+use_gpu()
+{
+    if (!instancing.initialized)
+        init_instancing();
+    return instancing.supported && !instancing.forced_fallback;
+}
+
+// Orphans the instance buffer and fills it, growing it when needed
+static void
+upload_instances(const void *data, size_t bytes)
+{
+    if (bytes > instancing.instance_capacity)
+        instancing.instance_capacity = bytes > instancing.instance_capacity * 2
+            ? bytes : instancing.instance_capacity * 2;
+
+    glBindBuffer(GL_ARRAY_BUFFER, instancing.instance_vbo);
+    glBufferData(GL_ARRAY_BUFFER, instancing.instance_capacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, data);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+static void
+load_shape(ShapeGeometry &shape)
+{
+    glGenVertexArrays(1, &shape.vao);
+    glGenBuffers(1, &shape.vbo);
+
+    glBindVertexArray(shape.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, shape.vbo);
+    glBufferData(GL_ARRAY_BUFFER, shape.vertices.size() * sizeof(Vector2),
+                 shape.vertices.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vector2), nullptr);
+
+    const GLsizei stride = sizeof(ShapeInstance);
+    glBindBuffer(GL_ARRAY_BUFFER, instancing.instance_vbo);
+    glEnableVertexAttribArray(INSTANCE_LOCATION_POSITION);
+    glVertexAttribPointer(INSTANCE_LOCATION_POSITION, 2, GL_FLOAT, GL_FALSE, stride,
+                          (void *) offsetof(ShapeInstance, position));
+    glEnableVertexAttribArray(INSTANCE_LOCATION_SCALE);
+    glVertexAttribPointer(INSTANCE_LOCATION_SCALE, 2, GL_FLOAT, GL_FALSE, stride,
+                          (void *) offsetof(ShapeInstance, scale));
+    glEnableVertexAttribArray(INSTANCE_LOCATION_ROTATION);
+    glVertexAttribPointer(INSTANCE_LOCATION_ROTATION, 1, GL_FLOAT, GL_FALSE, stride,
+                          (void *) offsetof(ShapeInstance, rotation));
+    glEnableVertexAttribArray(INSTANCE_LOCATION_COLOR);
+    glVertexAttribPointer(INSTANCE_LOCATION_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+                          (void *) offsetof(ShapeInstance, color));
+
+    glVertexAttribDivisor(INSTANCE_LOCATION_POSITION, 1);
+    glVertexAttribDivisor(INSTANCE_LOCATION_SCALE, 1);
+    glVertexAttribDivisor(INSTANCE_LOCATION_ROTATION, 1);
+    glVertexAttribDivisor(INSTANCE_LOCATION_COLOR, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Unit shapes, wound like the rlgl shape functions
+static ShapeGeometry &
+circle_geometry(int segments)
+{
+    ShapeGeometry &shape = instancing.circles[segments];
+    if (shape.vertices.empty())
+    {
+        for (int s = 0; s < segments; ++s)
+        {
+            float a0 = 2.0f * PI * s / segments;
+            float a1 = 2.0f * PI * (s + 1) / segments;
+            shape.vertices.push_back(Vector2 { 0.0f, 0.0f });
+            shape.vertices.push_back(Vector2 { std::cos(a1), std::sin(a1) });
+            shape.vertices.push_back(Vector2 { std::cos(a0), std::sin(a0) });
+        }
+    }
+    return shape;
+}
+
+static ShapeGeometry &
+quad_geometry()
+{
+    ShapeGeometry &shape = instancing.quad;
+    if (shape.vertices.empty())
+    {
+        shape.vertices = {
+            { -0.5f, -0.5f }, { -0.5f, 0.5f }, { 0.5f, 0.5f },
+            { -0.5f, -0.5f }, { 0.5f, 0.5f }, { 0.5f, -0.5f },
+        };
+    }
+    return shape;
+}
+
+static void
+draw_shapes_cpu(const ShapeGeometry &shape, const ShapeInstance *instances, int count)
+{
+    int per_instance = (int) shape.vertices.size();
+    StreamVertex *vertices = StreamReserve(count * per_instance);
+    StreamVertex *out = vertices;
+
+    for (int i = 0; i < count; ++i)
+    {
+        const ShapeInstance &instance = instances[i];
+        float s = std::sin(instance.rotation * DEG2RAD);
+        float c = std::cos(instance.rotation * DEG2RAD);
+
+        for (const Vector2 &v : shape.vertices)
+        {
+            float x = v.x * instance.scale.x;
+            float y = v.y * instance.scale.y;
+            *out++ = StreamMakeVertex(x * c - y * s + instance.position.x,
+                                      x * s + y * c + instance.position.y,
+                                      instance.color);
+        }
+    }
+    StreamDraw(STREAM_TRIANGLES, vertices, int(out - vertices));
+}
+
+static void
+draw_shapes(ShapeGeometry &shape, const ShapeInstance *instances, int count)
+{
+    if (instances == nullptr || count <= 0)
+        return;
+
+    rlDrawRenderBatchActive();
+
+    // Negative scales flip the winding, on both paths
+    GLboolean culling = glIsEnabled(GL_CULL_FACE);
+    glDisable(GL_CULL_FACE);
+
+    if (!use_gpu())
+    {
+        draw_shapes_cpu(shape, instances, count);
+    }
+    else
+    {
+        if (shape.vao == 0)
+            load_shape(shape);
+        upload_instances(instances, count * sizeof(ShapeInstance));
+
+        glUseProgram(instancing.shape_program);
+        glUniformMatrix4fv(instancing.shape_mvp, 1, GL_FALSE, MatrixToFloat(StreamGetMatrixMVP()));
+
+        glBindVertexArray(shape.vao);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, (GLsizei) shape.vertices.size(), count);
+        glBindVertexArray(0);
+        glUseProgram(0);
+    }
+
+    if (culling)
+        glEnable(GL_CULL_FACE);
+}
+
+void
+DrawCirclesInstanced(const ShapeInstance *instances, int count, int segments)
+{
+    draw_shapes(circle_geometry(segments < 3 ? 3 : segments), instances, count);
+}
+
+void
+DrawQuadsInstanced(const ShapeInstance *instances, int count)
+{
+    draw_shapes(quad_geometry(), instances, count);
+}
+
+static Color
+multiply(Color a, Color b)
+{
+    return Color {
+        (unsigned char) (a.r * b.r / 255), (unsigned char) (a.g * b.g / 255),
+        (unsigned char) (a.b * b.b / 255), (unsigned char) (a.a * b.a / 255)
+    };
+}
+
+void
+DrawMeshInstancedColored(Mesh mesh, Material material, const Matrix *transforms,
+                         const Color *colors, int count)
+{
+    if (transforms == nullptr || count <= 0)
+        return;
+
+    MaterialMap &diffuse = material.maps[MATERIAL_MAP_DIFFUSE];
+
+    if (!use_gpu())
+    {
+        Color base = diffuse.color;
+        for (int i = 0; i < count; ++i)
+        {
+            diffuse.color = colors != nullptr ? multiply(base, colors[i]) : base;
+            DrawMesh(mesh, material, transforms[i]);
+        }
+        diffuse.color = base;
+        return;
+    }
+
+    if (mesh.vaoId == 0)
+    {
+        TraceLog(LOG_WARNING, "INSTANCING: Mesh not uploaded, call UploadMesh() first");
+        return;
+    }
+
+    instancing.mesh_instances.resize(count);
+    for (int i = 0; i < count; ++i)
+    {
+        instancing.mesh_instances[i].transform = MatrixToFloatV(transforms[i]);
+        instancing.mesh_instances[i].color = colors != nullptr ? colors[i] : WHITE;
+    }
+
+    rlDrawRenderBatchActive();
+    upload_instances(instancing.mesh_instances.data(), count * sizeof(MeshInstance));
+
+    glUseProgram(instancing.mesh_program);
+    glUniformMatrix4fv(instancing.mesh_mvp, 1, GL_FALSE, MatrixToFloat(StreamGetMatrixMVP()));
+    glUniform4f(instancing.mesh_color, diffuse.color.r / 255.0f, diffuse.color.g / 255.0f,
+                diffuse.color.b / 255.0f, diffuse.color.a / 255.0f);
+    glUniform1i(instancing.mesh_texture, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, diffuse.texture.id != 0
+                  ? diffuse.texture.id : rlGetTextureIdDefault());
+
+    // The instance attributes live in the mesh VAO only for this draw
+    const GLsizei stride = sizeof(MeshInstance);
+    glBindVertexArray(mesh.vaoId);
+    glBindBuffer(GL_ARRAY_BUFFER, instancing.instance_vbo);
+    for (int column = 0; column < 4; ++column)
+    {
+        GLuint location = INSTANCE_LOCATION_TRANSFORM + column;
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, stride,
+                              (void *) (offsetof(MeshInstance, transform) + column * 4 * sizeof(float)));
+        glVertexAttribDivisor(location, 1);
+    }
+    glEnableVertexAttribArray(INSTANCE_LOCATION_TINT);
+    glVertexAttribPointer(INSTANCE_LOCATION_TINT, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+                          (void *) offsetof(MeshInstance, color));
+    glVertexAttribDivisor(INSTANCE_LOCATION_TINT, 1);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    if (mesh.indices != nullptr)
+        glDrawElementsInstanced(GL_TRIANGLES, mesh.triangleCount * 3, GL_UNSIGNED_SHORT,
+                                nullptr, count);
+    else
+        glDrawArraysInstanced(GL_TRIANGLES, 0, mesh.vertexCount, count);
+
+    for (GLuint location = INSTANCE_LOCATION_TRANSFORM; location <= INSTANCE_LOCATION_TINT; ++location)
+    {
+        glVertexAttribDivisor(location, 0);
+        glDisableVertexAttribArray(location);
+    }
+
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUseProgram(0);
+}
+
+bool
+IsInstancingSupported()
+{
+    if (!instancing.initialized)
+        init_instancing();
+    return instancing.supported;
+}
+
+void
+SetInstancingFallback(bool force)
+{
+    instancing.forced_fallback = force;
+}
@@ -0,0 +1,254 @@
+#include <raylib-ext/profiler.hpp>
+#include <raylib-ext.hpp>
+
+#ifdef RAYLIB_EXT_PROFILER
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define PROFILER_RDTSC
+#endif
+
+static_assert((PROFILER_RING_EVENTS & (PROFILER_RING_EVENTS - 1)) == 0,
+              "PROFILER_RING_EVENTS must be a power of two");
+
+struct ProfileEvent
+{
+    const char *name;
+    uint64_t start;
+    uint64_t end;
+};
+
+struct ProfileThread
+{
+    int id = 0;
+    const char *name = nullptr;
+
+    // Events ever recorded; the ring keeps the last PROFILER_RING_EVENTS
+    std::atomic<uint64_t> count { 0 };
+    std::vector<ProfileEvent> events;
+
+    // Open PROFILE_BEGIN() scopes
+    ProfileEvent stack[PROFILER_MAX_DEPTH];
+    int depth = 0;
+};
+
+struct ProfilerState
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ProfileThread>> threads;
+
+    // Timestamps are converted to microseconds against these at export
+    uint64_t origin_ticks = ProfileNow();
+    std::chrono::steady_clock::time_point origin_time = std::chrono::steady_clock::now();
+};
+
+static ProfilerState &
+profiler()
+{
+    static ProfilerState state;
+    return state;
+}
+
+static thread_local ProfileThread *profile_thread = nullptr;
+
+static ProfileThread &
+this_thread()
+{
+    if (profile_thread == nullptr)
+    {
+        ProfilerState &state = profiler();
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        state.threads.push_back(std::make_unique<ProfileThread>());
+        profile_thread = state.threads.back().get();
+        profile_thread->id = int(state.threads.size()) - 1;
+        profile_thread->events.resize(PROFILER_RING_EVENTS);
+    }
+    return *profile_thread;
+}
+
+static void
+write_json_string(std::FILE *file, const char *text)
+{
+    std::fputc('"', file);
+    for (const char *c = text; *c != '\0'; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+            std::fputc('\\', file);
+        if ((unsigned char)(*c) >= 0x20)
+            std::fputc(*c, file);
+    }
+    std::fputc('"', file);
+}
+
+/* Profiler */
+
+uint64_t
+ProfileNow()
+{
+#ifdef PROFILER_RDTSC
+    return __rdtsc();
+#else
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count());
+#endif
+}
+
+void
+ProfileRecord(const char *name, uint64_t start, uint64_t end)
+{
+    ProfileThread &thread = this_thread();
+    uint64_t n = thread.count.load(std::memory_order_relaxed);
+    thread.events[n & (PROFILER_RING_EVENTS - 1)] = { name, start, end };
+    thread.count.store(n + 1, std::memory_order_release);
+}
+
+void
+ProfileBegin(const char *name)
+{
+    ProfileThread &thread = this_thread();
+    if (thread.depth < PROFILER_MAX_DEPTH)
+        thread.stack[thread.depth] = { name, ProfileNow(), 0 };
+    thread.depth++;
+}
+
+void
+ProfileEnd()
+{
+    uint64_t end = ProfileNow();
+    ProfileThread &thread = this_thread();
+    if (thread.depth == 0)
+        return;
+
+    thread.depth--;
+    if (thread.depth < PROFILER_MAX_DEPTH)
+    {
+        const ProfileEvent &open = thread.stack[thread.depth];
+        ProfileRecord(open.name, open.start, end);
+    }
+}
+
+void
+SetProfileThreadName(const char *name)
+{
+    this_thread().name = name;
+}
+
+void
+ResetProfile()
+{
+    ProfilerState &state = profiler();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    for (auto &thread : state.threads)
+        thread->count.store(0, std::memory_order_relaxed);
+}
+
+bool
+ExportProfile(const char *fileName)
+{
+    ProfilerState &state = profiler();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    // rdtsc ticks per microsecond, measured over the whole run
+    double ticks_per_us = 1000.0;
+#ifdef PROFILER_RDTSC
+    double elapsed_us = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - state.origin_time
+    ).count();
+    if (elapsed_us > 0.0)
+        ticks_per_us = double(ProfileNow() - state.origin_ticks) / elapsed_us;
+#endif
+
+    std::FILE *file = std::fopen(fileName, "w");
+    if (file == nullptr)
+    {
+        TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to export profile", fileName);
+        return false;
+    }
+
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool first = true;
+    uint64_t written = 0;
+
+    for (auto &thread : state.threads)
+    {
+        std::fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                           "\"args\":{\"name\":", first ? "" : ",", thread->id);
+        if (thread->name != nullptr)
+            write_json_string(file, thread->name);
+        else
+            std::fprintf(file, "\"thread %d\"", thread->id);
+        std::fprintf(file, "}}");
+        first = false;
+
+        uint64_t count = thread->count.load(std::memory_order_acquire);
+        uint64_t begin = count > PROFILER_RING_EVENTS ? count - PROFILER_RING_EVENTS : 0;
+        for (uint64_t n = begin; n < count; ++n)
+        {
+            const ProfileEvent &event = thread->events[n & (PROFILER_RING_EVENTS - 1)];
+            double ts = double(int64_t(event.start - state.origin_ticks)) / ticks_per_us;
+            double dur = double(event.end - event.start) / ticks_per_us;
+
+            std::fprintf(file, ",\n{\"name\":");
+            write_json_string(file, event.name);
+            std::fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                         thread->id, ts, dur);
+        }
+        written += count - begin;
+    }
+
+    std::fprintf(file, "\n]}\n");
+    bool ok = std::fclose(file) == 0;
+
+    if (ok)
+        TraceLog(LOG_INFO, "PROFILER: [%s] %llu scopes exported", fileName,
+                 (unsigned long long)written);
+    else
+        TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to export profile", fileName);
+    return ok;
+}
+
+#else
+
+uint64_t
+ProfileNow()
+{
+    return 0;
+}
+
+void
+ProfileRecord(const char *, uint64_t, uint64_t) {}
+
+void
+ProfileBegin(const char *) {}
+
+void
+ProfileEnd() {}
+
+void
+SetProfileThreadName(const char *) {}
+
+void
+ResetProfile() {}
+
+bool
+ExportProfile(const char *fileName)
+{
+    TraceLog(LOG_WARNING, "PROFILER: [%s] Not exported, built without RAYLIB_EXT_PROFILER",
+             fileName);
+    return false;
+}
+
+#endif // RAYLIB_EXT_PROFILER
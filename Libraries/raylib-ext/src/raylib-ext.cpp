@@ -7,6 +7,7 @@ extern "C" {
 }
 
 #include <raylib-ext.hpp>
+#include <raylib-ext/profiler.hpp>
 
 /* Vector2 */
 
@@ -460,12 +461,14 @@ SetClipboardText(const std::string &text)
 Shader
 LoadShader(const std::string &vsFileName, const std::string &fsFileName)
 {
+    PROFILE_FUNCTION();
     return LoadShader(vsFileName.c_str(), fsFileName.c_str());
 }
 
 Shader
 LoadShaderFromMemory(const std::string &vsCode, const std::string &fsCode)
 {
+    PROFILE_FUNCTION();
     return LoadShaderFromMemory(vsCode.c_str(), fsCode.c_str());
 }
 
@@ -490,6 +493,7 @@ TakeScreenshot(const std::string &fileName)
 unsigned char *
 LoadFileData(const std::string &fileName, unsigned int *bytesRead)
 {
+    PROFILE_FUNCTION();
     return LoadFileData(fileName.c_str(), bytesRead);
 }
 
@@ -502,6 +506,7 @@ SaveFileData(const std::string &fileName, void *data, unsigned int bytesToWrite)
 char *
 LoadFileText(const std::string &fileName)
 {
+    PROFILE_FUNCTION();
     return LoadFileText(fileName.c_str());
 }
 
@@ -582,6 +587,7 @@ OpenURL(const std::string &url)
 Image
 LoadImage(const std::string &fileName)
 {
+    PROFILE_FUNCTION();
     return LoadImage(fileName.c_str());
 }
 
@@ -589,12 +595,14 @@ Image
 LoadImageRaw(const std::string &fileName, int width, int height, int format,
              int headerSize)
 {
+    PROFILE_FUNCTION();
     return LoadImageRaw(fileName.c_str(), width, height, format, headerSize);
 }
 
 Image
 LoadImageAnim(const std::string &fileName, int *frames)
 {
+    PROFILE_FUNCTION();
     return LoadImageAnim(fileName.c_str(), frames);
 }
 
@@ -602,6 +610,7 @@ Image
 LoadImageFromMemory(const std::string &fileType, const unsigned char *fileData,
                     int dataSize)
 {
+    PROFILE_FUNCTION();
     return LoadImageFromMemory(fileType.c_str(), fileData, dataSize);
 }
 
@@ -647,6 +656,7 @@ ImageDrawTextEx(Image *dst, Font font, const std::string &text,
 Texture2D
 LoadTexture(const std::string &fileName)
 {
+    PROFILE_FUNCTION();
     return LoadTexture(fileName.c_str());
 }
 
@@ -655,6 +665,7 @@ LoadTexture(const std::string &fileName)
 Font
 LoadFont(const std::string &fileName)
 {
+    PROFILE_FUNCTION();
     return LoadFont(fileName.c_str());
 }
 
@@ -662,6 +673,7 @@ Font
 LoadFontEx(const std::string &fileName, int fontSize, int *fontChars,
            int glyphCount)
 {
+    PROFILE_FUNCTION();
     return LoadFontEx(fileName.c_str(), fontSize, fontChars, glyphCount);
 }
 
@@ -669,6 +681,7 @@ Font
 LoadFontFromMemory(const std::string &fileType, const unsigned char *fileData,
                    int dataSize, int fontSize, int *fontChars, int glyphCount)
 {
+    PROFILE_FUNCTION();
     return LoadFontFromMemory(fileType.c_str(), fileData, dataSize, fontSize,
                               fontChars, glyphCount);
 }
@@ -730,6 +743,7 @@ GetCodepoint(const std::string &text, int *bytesProcessed)
 Model
 LoadModel(const std::string &fileName)
 {
+    PROFILE_FUNCTION();
     return LoadModel(fileName.c_str());
 }
 
@@ -742,12 +756,14 @@ ExportMesh(Mesh mesh, const std::string &fileName)
 Material*
 LoadMaterials(const std::string &fileName, int *materialCount)
 {
+    PROFILE_FUNCTION();
     return LoadMaterials(fileName.c_str(), materialCount);
 }
 
 ModelAnimation*
 LoadModelAnimations(const std::string &fileName, unsigned int *animCount)
 {
+    PROFILE_FUNCTION();
     return LoadModelAnimations(fileName.c_str(), animCount);
 }
 
@@ -756,6 +772,7 @@ LoadModelAnimations(const std::string &fileName, unsigned int *animCount)
 Wave
 LoadWave(const std::string &fileName)
 {
+    PROFILE_FUNCTION();
     return LoadWave(fileName.c_str());
 }
 
@@ -763,12 +780,14 @@ Wave
 LoadWaveFromMemory(const std::string &fileType, const unsigned char *fileData,
                    int dataSize)
 {
+    PROFILE_FUNCTION();
     return LoadWaveFromMemory(fileType.c_str(), fileData, dataSize);
 }
 
 Sound
 LoadSound(const std::string &fileName)
 {
+    PROFILE_FUNCTION();
     return LoadSound(fileName.c_str());
 }
 
@@ -787,6 +806,7 @@ ExportWaveAsCode(Wave wave, const std::string &fileName)
 Music
 LoadMusicStream(const std::string &fileName)
 {
+    PROFILE_FUNCTION();
     return LoadMusicStream(fileName.c_str());
 }
 
@@ -795,6 +815,7 @@ LoadMusicStreamFromMemory(const std::string &fileType,
                           const unsigned char *data,
                           int dataSize)
 {
+    PROFILE_FUNCTION();
     return LoadMusicStreamFromMemory(fileType.c_str(), data, dataSize);
 }
 
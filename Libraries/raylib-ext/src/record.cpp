@@ -0,0 +1,237 @@
+#include <raylib-ext/record.hpp>
+
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "stream.hpp"
+
+struct RecordedDraw
+{
+    GLenum mode;
+    GLuint texture;
+    int first;
+    int count;
+};
+
+struct Recording
+{
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    std::vector<RecordedDraw> draws;
+};
+
+struct Recorder
+{
+    bool recording = false;
+    bool batch_loaded = false;
+    rlRenderBatch batch = {};
+    PFNGLBUFFERSUBDATAPROC buffer_sub_data = nullptr;
+
+    std::vector<StreamVertex> vertices;
+    std::vector<RecordedDraw> draws;
+    std::vector<Recording> recordings;  // indexed by id - 1
+};
+
+static Recorder recorder;
+
+static void
+append_vertex(const rlVertexBuffer &buffer, int index)
+{
+    const float *position = buffer.vertices + index * 3;
+    const float *texcoord = buffer.texcoords + index * 2;
+    const unsigned char *color = buffer.colors + index * 4;
+
+    recorder.vertices.push_back(StreamVertex {
+        position[0], position[1], position[2],
+        texcoord[0], texcoord[1],
+        color[0], color[1], color[2], color[3]
+    });
+}
+
+static void
+append_draw(GLenum mode, GLuint texture, int first, int count)
+{
+    if (!recorder.draws.empty())
+    {
+        RecordedDraw &last = recorder.draws.back();
+        if (last.mode == mode && last.texture == texture && last.first + last.count == first)
+        {
+            last.count += count;
+            return;
+        }
+    }
+    recorder.draws.push_back(RecordedDraw { mode, texture, first, count });
+}
+
+// Copies the queued draws out of the recording batch, quads split into
+// triangles, and empties them so the flush in progress draws nothing
+static void
+collect_batch()
+{
+    rlRenderBatch &batch = recorder.batch;
+    const rlVertexBuffer &buffer = batch.vertexBuffer[batch.currentBuffer];
+
+    for (int i = 0, offset = 0; i < batch.drawCounter; ++i)
+    {
+        rlDrawCall &draw = batch.draws[i];
+        int first = (int) recorder.vertices.size();
+
+        if (draw.mode == RL_QUADS)
+        {
+            for (int quad = offset; quad + 3 < offset + draw.vertexCount; quad += 4)
+            {
+                append_vertex(buffer, quad);
+                append_vertex(buffer, quad + 1);
+                append_vertex(buffer, quad + 2);
+                append_vertex(buffer, quad);
+                append_vertex(buffer, quad + 2);
+                append_vertex(buffer, quad + 3);
+            }
+        }
+        else
+        {
+            for (int v = offset; v < offset + draw.vertexCount; ++v)
+                append_vertex(buffer, v);
+        }
+
+        int count = (int) recorder.vertices.size() - first;
+        if (count > 0)
+            append_draw(draw.mode == RL_LINES ? GL_LINES : GL_TRIANGLES,
+                        draw.textureId, first, count);
+
+        offset += draw.vertexCount + draw.vertexAlignment;
+        draw.vertexCount = 0;
+    }
+}
+
+static void APIENTRY
+hook_buffer_sub_data(GLenum target, GLintptr offset, GLsizeiptr size, const void *data)
+{
+    // rlDrawRenderBatch() uploads positions first, straight from the batch
+    const rlRenderBatch &batch = recorder.batch;
+    if (target == GL_ARRAY_BUFFER && data == batch.vertexBuffer[batch.currentBuffer].vertices)
+        collect_batch();
+
+    recorder.buffer_sub_data(target, offset, size, data);
+}
+
+static Recording *
+find_recording(unsigned int id)
+{
+    if (id == 0 || id > recorder.recordings.size())
+        return nullptr;
+
+    Recording &recording = recorder.recordings[id - 1];
+    return recording.vao != 0 ? &recording : nullptr;
+}
+
+void
+BeginRecord()
+{
+    if (recorder.recording)
+    {
+        TraceLog(LOG_WARNING, "RECORD: Already recording, call EndRecord() first");
+        return;
+    }
+
+    if (!recorder.batch_loaded)
+    {
+        recorder.batch = rlLoadRenderBatch(1, RL_DEFAULT_BATCH_BUFFER_ELEMENTS);
+        recorder.batch_loaded = true;
+    }
+
+    recorder.vertices.clear();
+    recorder.draws.clear();
+
+    // Flushes what was drawn so far before the hook goes in. Flushes of the
+    // recording batch, including the ones rlgl does when it fills up, are
+    // collected, so recordings are not limited to one batch.
+    PushRenderBatch(&recorder.batch);
+
+    recorder.buffer_sub_data = glad_glBufferSubData;
+    glad_glBufferSubData = hook_buffer_sub_data;
+    recorder.recording = true;
+}
+
+RecordedGeometry
+EndRecord()
+{
+    RecordedGeometry recorded = { 0, 0, 0 };
+    if (!recorder.recording)
+    {
+        TraceLog(LOG_WARNING, "RECORD: Not recording, call BeginRecord() first");
+        return recorded;
+    }
+
+    rlDrawRenderBatchActive();
+    PopRenderBatch(&recorder.batch);
+
+    glad_glBufferSubData = recorder.buffer_sub_data;
+    recorder.recording = false;
+
+    if (recorder.vertices.empty())
+        return recorded;
+
+    Recording recording;
+    glGenBuffers(1, &recording.vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, recording.vbo);
+    glBufferData(GL_ARRAY_BUFFER, recorder.vertices.size() * sizeof(StreamVertex),
+                 recorder.vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    recording.vao = StreamLoadVertexArray(recording.vbo);
+    recording.draws = recorder.draws;
+
+    size_t slot = 0;
+    while (slot < recorder.recordings.size() && recorder.recordings[slot].vao != 0)
+        slot++;
+    if (slot == recorder.recordings.size())
+        recorder.recordings.emplace_back();
+    recorder.recordings[slot] = std::move(recording);
+
+    recorded.id = (unsigned int) slot + 1;
+    recorded.vertex_count = (int) recorder.vertices.size();
+    recorded.draw_count = (int) recorder.draws.size();
+
+    TraceLog(LOG_INFO, "RECORD: [ID %u] Recorded %d vertices in %d draws",
+             recorded.id, recorded.vertex_count, recorded.draw_count);
+    return recorded;
+}
+
+bool
+IsRecordedReady(RecordedGeometry recorded)
+{
+    return find_recording(recorded.id) != nullptr;
+}
+
+void
+DrawRecorded(RecordedGeometry recorded, Matrix transform, Color tint)
+{
+    const Recording *recording = find_recording(recorded.id);
+    if (recording == nullptr)
+        return;
+
+    rlDrawRenderBatchActive();
+    StreamBeginShader(Shader { 0, nullptr }, transform, tint);
+    glBindVertexArray(recording->vao);
+
+    for (const RecordedDraw &draw : recording->draws)
+    {
+        glBindTexture(GL_TEXTURE_2D, draw.texture);
+        glDrawArrays(draw.mode, draw.first, draw.count);
+    }
+
+    StreamEndShader();
+}
+
+void
+UnloadRecorded(RecordedGeometry recorded)
+{
+    Recording *recording = find_recording(recorded.id);
+    if (recording == nullptr)
+        return;
+
+    glDeleteVertexArrays(1, &recording->vao);
+    glDeleteBuffers(1, &recording->vbo);
+    *recording = Recording();
+}
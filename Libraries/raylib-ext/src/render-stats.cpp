@@ -0,0 +1,363 @@
+#include <raylib-ext/render-stats.hpp>
+
+#include <cstdio>
+
+#include <glad/glad.h>
+
+#include "stream.hpp"
+
+// Flushes with less than this many free vertices left are blamed on the
+// vertex limit; rlCheckRenderBatchLimit() trips before the buffer is full
+#define RENDER_STATS_VERTEX_SLACK_DIVISOR 8
+
+struct RenderStatsState
+{
+    bool enabled = false;
+    rlRenderBatch batch = {};
+
+    RenderStats current = {};
+    RenderStats last = {};
+    int last_cause = -1;
+
+    GLuint array_buffer = 0;
+    GLuint texture = 0;
+    GLuint program = 0;
+    bool in_flush = false;
+
+    PFNGLDRAWARRAYSPROC draw_arrays = nullptr;
+    PFNGLDRAWELEMENTSPROC draw_elements = nullptr;
+    PFNGLDRAWARRAYSINSTANCEDPROC draw_arrays_instanced = nullptr;
+    PFNGLDRAWELEMENTSINSTANCEDPROC draw_elements_instanced = nullptr;
+    PFNGLBINDBUFFERPROC bind_buffer = nullptr;
+    PFNGLBUFFERDATAPROC buffer_data = nullptr;
+    PFNGLBUFFERSUBDATAPROC buffer_sub_data = nullptr;
+    PFNGLBINDTEXTUREPROC bind_texture = nullptr;
+    PFNGLUSEPROGRAMPROC use_program = nullptr;
+    PFNGLTEXIMAGE2DPROC tex_image_2d = nullptr;
+    PFNGLTEXSUBIMAGE2DPROC tex_sub_image_2d = nullptr;
+};
+
+static RenderStatsState render_stats;
+
+static uint64_t
+pixel_bytes(GLsizei width, GLsizei height, GLenum format, GLenum type)
+{
+    int channels = 4;
+    switch (format)
+    {
+        case GL_RED: channels = 1; break;
+        case GL_RG: channels = 2; break;
+        case GL_RGB: channels = 3; break;
+        default: break;
+    }
+
+    int size = 1;
+    switch (type)
+    {
+        case GL_HALF_FLOAT: size = 2; break;
+        case GL_FLOAT: size = 4; break;
+        case GL_UNSIGNED_SHORT_5_6_5:
+        case GL_UNSIGNED_SHORT_5_5_5_1:
+        case GL_UNSIGNED_SHORT_4_4_4_4: size = 2; channels = 1; break;
+        default: break;
+    }
+
+    return uint64_t(width) * height * channels * size;
+}
+
+static bool
+is_batch_vertex_buffer(GLuint buffer)
+{
+    for (int i = 0; i < render_stats.batch.bufferCount; ++i)
+        if (render_stats.batch.vertexBuffer[i].vboId[0] == buffer)
+            return true;
+    return false;
+}
+
+static void
+record_flush(GLsizeiptr bytes)
+{
+    const rlRenderBatch &batch = render_stats.batch;
+    int vertices = int(bytes / (3 * sizeof(float)));
+    int capacity = batch.vertexBuffer[0].elementCount * 4;
+
+    FlushCause cause = FLUSH_STATE_CHANGE;
+    if (batch.drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS)
+        cause = FLUSH_DRAWCALL_LIMIT;
+    else if (vertices >= capacity - capacity / RENDER_STATS_VERTEX_SLACK_DIVISOR)
+        cause = FLUSH_VERTEX_LIMIT;
+
+    render_stats.current.flushes++;
+    render_stats.current.flushes_by_cause[cause]++;
+    render_stats.last_cause = cause;
+    render_stats.in_flush = true;
+}
+
+/* GL hooks */
+
+static void APIENTRY
+hook_draw_arrays(GLenum mode, GLint first, GLsizei count)
+{
+    render_stats.current.draw_calls++;
+    render_stats.current.vertices += count;
+    render_stats.draw_arrays(mode, first, count);
+}
+
+static void APIENTRY
+hook_draw_elements(GLenum mode, GLsizei count, GLenum type, const void *indices)
+{
+    // rlgl draws quads as 6 indices over 4 vertices
+    render_stats.current.draw_calls++;
+    render_stats.current.vertices += render_stats.in_flush ? count / 6 * 4 : count;
+    render_stats.draw_elements(mode, count, type, indices);
+}
+
+static void APIENTRY
+hook_draw_arrays_instanced(GLenum mode, GLint first, GLsizei count, GLsizei instances)
+{
+    render_stats.current.draw_calls++;
+    render_stats.current.vertices += uint64_t(count) * instances;
+    render_stats.draw_arrays_instanced(mode, first, count, instances);
+}
+
+static void APIENTRY
+hook_draw_elements_instanced(GLenum mode, GLsizei count, GLenum type,
+                             const void *indices, GLsizei instances)
+{
+    render_stats.current.draw_calls++;
+    render_stats.current.vertices += uint64_t(count) * instances;
+    render_stats.draw_elements_instanced(mode, count, type, indices, instances);
+}
+
+static void APIENTRY
+hook_bind_buffer(GLenum target, GLuint buffer)
+{
+    if (target == GL_ARRAY_BUFFER)
+        render_stats.array_buffer = buffer;
+    render_stats.bind_buffer(target, buffer);
+}
+
+static void APIENTRY
+hook_buffer_data(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
+{
+    if (data != nullptr)
+        render_stats.current.upload_bytes += size;
+    render_stats.buffer_data(target, size, data, usage);
+}
+
+static void APIENTRY
+hook_buffer_sub_data(GLenum target, GLintptr offset, GLsizeiptr size, const void *data)
+{
+    render_stats.current.upload_bytes += size;
+
+    // rlDrawRenderBatch() starts by uploading the vertex positions, while
+    // the batch still holds the draws that caused the flush
+    if (target == GL_ARRAY_BUFFER && is_batch_vertex_buffer(render_stats.array_buffer))
+        record_flush(size);
+
+    render_stats.buffer_sub_data(target, offset, size, data);
+}
+
+static void APIENTRY
+hook_bind_texture(GLenum target, GLuint texture)
+{
+    if (texture != 0 && texture != render_stats.texture)
+    {
+        render_stats.current.texture_switches++;
+        render_stats.texture = texture;
+    }
+    render_stats.bind_texture(target, texture);
+}
+
+static void APIENTRY
+hook_use_program(GLuint program)
+{
+    if (program == 0)
+        render_stats.in_flush = false;
+    else if (program != render_stats.program)
+    {
+        render_stats.current.shader_switches++;
+        render_stats.program = program;
+    }
+    render_stats.use_program(program);
+}
+
+static void APIENTRY
+hook_tex_image_2d(GLenum target, GLint level, GLint internalformat, GLsizei width,
+                  GLsizei height, GLint border, GLenum format, GLenum type,
+                  const void *pixels)
+{
+    if (pixels != nullptr)
+        render_stats.current.upload_bytes += pixel_bytes(width, height, format, type);
+    render_stats.tex_image_2d(target, level, internalformat, width, height, border,
+                              format, type, pixels);
+}
+
+static void APIENTRY
+hook_tex_sub_image_2d(GLenum target, GLint level, GLint xoffset, GLint yoffset,
+                      GLsizei width, GLsizei height, GLenum format, GLenum type,
+                      const void *pixels)
+{
+    if (pixels != nullptr)
+        render_stats.current.upload_bytes += pixel_bytes(width, height, format, type);
+    render_stats.tex_sub_image_2d(target, level, xoffset, yoffset, width, height,
+                                  format, type, pixels);
+}
+
+/* Public API */
+
+void
+EnableRenderStats()
+{
+    if (render_stats.enabled)
+        return;
+
+    if (!IsWindowReady())
+    {
+        TraceLog(LOG_WARNING, "RENDERSTATS: Window not ready, call InitWindow() first");
+        return;
+    }
+
+    render_stats.batch = rlLoadRenderBatch(RL_DEFAULT_BATCH_BUFFERS,
+                                           RL_DEFAULT_BATCH_BUFFER_ELEMENTS);
+
+    render_stats.draw_arrays = glad_glDrawArrays;
+    render_stats.draw_elements = glad_glDrawElements;
+    render_stats.draw_arrays_instanced = glad_glDrawArraysInstanced;
+    render_stats.draw_elements_instanced = glad_glDrawElementsInstanced;
+    render_stats.bind_buffer = glad_glBindBuffer;
+    render_stats.buffer_data = glad_glBufferData;
+    render_stats.buffer_sub_data = glad_glBufferSubData;
+    render_stats.bind_texture = glad_glBindTexture;
+    render_stats.use_program = glad_glUseProgram;
+    render_stats.tex_image_2d = glad_glTexImage2D;
+    render_stats.tex_sub_image_2d = glad_glTexSubImage2D;
+
+    glad_glDrawArrays = hook_draw_arrays;
+    glad_glDrawElements = hook_draw_elements;
+    glad_glDrawArraysInstanced = hook_draw_arrays_instanced;
+    glad_glDrawElementsInstanced = hook_draw_elements_instanced;
+    glad_glBindBuffer = hook_bind_buffer;
+    glad_glBufferData = hook_buffer_data;
+    glad_glBufferSubData = hook_buffer_sub_data;
+    glad_glBindTexture = hook_bind_texture;
+    glad_glUseProgram = hook_use_program;
+    glad_glTexImage2D = hook_tex_image_2d;
+    glad_glTexSubImage2D = hook_tex_sub_image_2d;
+
+    render_stats.current = {};
+    render_stats.last = {};
+    render_stats.last_cause = -1;
+    render_stats.enabled = true;
+
+    // Flushes the default batch, anything drawn from now on goes to ours
+    PushRenderBatch(&render_stats.batch);
+}
+
+void
+DisableRenderStats()
+{
+    if (!render_stats.enabled)
+        return;
+
+    PopRenderBatch(&render_stats.batch);
+
+    glad_glDrawArrays = render_stats.draw_arrays;
+    glad_glDrawElements = render_stats.draw_elements;
+    glad_glDrawArraysInstanced = render_stats.draw_arrays_instanced;
+    glad_glDrawElementsInstanced = render_stats.draw_elements_instanced;
+    glad_glBindBuffer = render_stats.bind_buffer;
+    glad_glBufferData = render_stats.buffer_data;
+    glad_glBufferSubData = render_stats.buffer_sub_data;
+    glad_glBindTexture = render_stats.bind_texture;
+    glad_glUseProgram = render_stats.use_program;
+    glad_glTexImage2D = render_stats.tex_image_2d;
+    glad_glTexSubImage2D = render_stats.tex_sub_image_2d;
+
+    rlUnloadRenderBatch(render_stats.batch);
+    render_stats.batch = {};
+    render_stats.enabled = false;
+}
+
+bool
+IsRenderStatsEnabled()
+{
+    return render_stats.enabled;
+}
+
+void
+UpdateRenderStats()
+{
+    if (!render_stats.enabled)
+        return;
+
+    // EndDrawing() flushes whatever is left, which looks like any other
+    // state change flush from here
+    RenderStats &current = render_stats.current;
+    if (render_stats.last_cause == FLUSH_STATE_CHANGE)
+    {
+        current.flushes_by_cause[FLUSH_STATE_CHANGE]--;
+        current.flushes_by_cause[FLUSH_FRAME_END]++;
+    }
+
+    render_stats.last = current;
+    render_stats.current = {};
+    render_stats.last_cause = -1;
+
+    // rlgl binds the program and textures again every flush, so only count
+    // switches within a frame
+    render_stats.texture = 0;
+    render_stats.program = 0;
+}
+
+RenderStats
+GetRenderStats()
+{
+    return render_stats.last;
+}
+
+const char *
+GetFlushCauseName(FlushCause cause)
+{
+    switch (cause)
+    {
+        case FLUSH_VERTEX_LIMIT: return "vertex limit";
+        case FLUSH_DRAWCALL_LIMIT: return "drawcall limit";
+        case FLUSH_STATE_CHANGE: return "state change";
+        case FLUSH_FRAME_END: return "frame end";
+        default: return "unknown";
+    }
+}
+
+void
+DrawRenderStats(int x, int y)
+{
+    const int font_size = 10;
+    const int line_height = 12;
+    const int line_count = 10;
+    const RenderStats &stats = render_stats.last;
+
+    if (!render_stats.enabled)
+    {
+        DrawRectangle(x, y, 170, line_height + 8, Fade(BLACK, 0.7f));
+        DrawText("render stats disabled", x + 4, y + 4, font_size, RAYWHITE);
+        return;
+    }
+
+    // TextFormat() only rotates through a few buffers, format each line here
+    char lines[line_count][64];
+    std::snprintf(lines[0], 64, "draw calls     %d", stats.draw_calls);
+    std::snprintf(lines[1], 64, "flushes        %d", stats.flushes);
+    std::snprintf(lines[2], 64, "  vertex limit %d", stats.flushes_by_cause[FLUSH_VERTEX_LIMIT]);
+    std::snprintf(lines[3], 64, "  call limit   %d", stats.flushes_by_cause[FLUSH_DRAWCALL_LIMIT]);
+    std::snprintf(lines[4], 64, "  state change %d", stats.flushes_by_cause[FLUSH_STATE_CHANGE]);
+    std::snprintf(lines[5], 64, "  frame end    %d", stats.flushes_by_cause[FLUSH_FRAME_END]);
+    std::snprintf(lines[6], 64, "vertices       %llu", (unsigned long long) stats.vertices);
+    std::snprintf(lines[7], 64, "tex switches   %d", stats.texture_switches);
+    std::snprintf(lines[8], 64, "shader switch  %d", stats.shader_switches);
+    std::snprintf(lines[9], 64, "uploads        %.1f KB", stats.upload_bytes / 1024.0);
+
+    DrawRectangle(x, y, 170, line_count * line_height + 8, Fade(BLACK, 0.7f));
+    for (int i = 0; i < line_count; ++i)
+        DrawText(lines[i], x + 4, y + 4 + i * line_height, font_size, RAYWHITE);
+}
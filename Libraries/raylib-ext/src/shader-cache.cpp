@@ -0,0 +1,326 @@
+#include <raylib-ext/shader-cache.hpp>
+#include <raylib-ext/profiler.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#define SHADER_CACHE_MAGIC   0x43534c52  // "RLSC"
+#define SHADER_CACHE_VERSION 1
+
+// Not part of the GL 3.3 core loader
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH           0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS      0x87FE
+
+typedef void (APIENTRYP GetProgramBinaryProc)(GLuint program, GLsizei bufSize,
+                                              GLsizei *length, GLenum *binaryFormat,
+                                              void *binary);
+typedef void (APIENTRYP ProgramBinaryProc)(GLuint program, GLenum binaryFormat,
+                                           const void *binary, GLsizei length);
+typedef void (APIENTRYP ProgramParameteriProc)(GLuint program, GLenum pname, GLint value);
+
+struct ShaderCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t format;
+    uint32_t length;
+};
+
+struct ShaderCache
+{
+    bool initialized = false;
+    GetProgramBinaryProc get_program_binary = nullptr;
+    ProgramBinaryProc program_binary = nullptr;
+    ProgramParameteriProc program_parameteri = nullptr;
+    uint64_t driver_hash = 0;
+    std::string directory = "shader-cache";
+    ShaderCacheStats stats = {};
+};
+
+static ShaderCache shader_cache;
+
+static uint64_t
+hash_string(const std::string &text, uint64_t hash = 14695981039346656037ull)
+{
+    for (unsigned char c : text)
+    {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static const char *
+gl_string(GLenum name)
+{
+    const char *value = (const char *) glGetString(name);
+    return value != nullptr ? value : "";
+}
+
+static bool
+init_cache()
+{
+    if (!shader_cache.initialized)
+    {
+        shader_cache.initialized = true;
+
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        if (formats > 0)
+        {
+            shader_cache.get_program_binary =
+                (GetProgramBinaryProc) glfwGetProcAddress("glGetProgramBinary");
+            shader_cache.program_binary =
+                (ProgramBinaryProc) glfwGetProcAddress("glProgramBinary");
+            shader_cache.program_parameteri =
+                (ProgramParameteriProc) glfwGetProcAddress("glProgramParameteri");
+        }
+
+        std::string driver = std::string(gl_string(GL_VENDOR)) + "\n"
+                           + gl_string(GL_RENDERER) + "\n" + gl_string(GL_VERSION);
+        shader_cache.driver_hash = hash_string(driver);
+
+        if (shader_cache.get_program_binary == nullptr || shader_cache.program_binary == nullptr)
+            TraceLog(LOG_INFO, "SHADER CACHE: Program binaries not supported, caching disabled");
+    }
+
+    return shader_cache.get_program_binary != nullptr && shader_cache.program_binary != nullptr;
+}
+
+static std::string
+cache_path(uint64_t key)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long) key);
+    return shader_cache.directory + "/" + name;
+}
+
+// Same default locations LoadShaderFromMemory() sets up
+static Shader
+make_shader(unsigned int id)
+{
+    Shader shader = {};
+    shader.id = id;
+    shader.locs = (int *) std::calloc(RL_MAX_SHADER_LOCATIONS, sizeof(int));
+    for (int i = 0; i < RL_MAX_SHADER_LOCATIONS; ++i)
+        shader.locs[i] = -1;
+
+    shader.locs[SHADER_LOC_VERTEX_POSITION] = rlGetLocationAttrib(id, "vertexPosition");
+    shader.locs[SHADER_LOC_VERTEX_TEXCOORD01] = rlGetLocationAttrib(id, "vertexTexCoord");
+    shader.locs[SHADER_LOC_VERTEX_TEXCOORD02] = rlGetLocationAttrib(id, "vertexTexCoord2");
+    shader.locs[SHADER_LOC_VERTEX_NORMAL] = rlGetLocationAttrib(id, "vertexNormal");
+    shader.locs[SHADER_LOC_VERTEX_TANGENT] = rlGetLocationAttrib(id, "vertexTangent");
+    shader.locs[SHADER_LOC_VERTEX_COLOR] = rlGetLocationAttrib(id, "vertexColor");
+
+    shader.locs[SHADER_LOC_MATRIX_MVP] = rlGetLocationUniform(id, "mvp");
+    shader.locs[SHADER_LOC_MATRIX_VIEW] = rlGetLocationUniform(id, "matView");
+    shader.locs[SHADER_LOC_MATRIX_PROJECTION] = rlGetLocationUniform(id, "matProjection");
+    shader.locs[SHADER_LOC_MATRIX_MODEL] = rlGetLocationUniform(id, "matModel");
+    shader.locs[SHADER_LOC_MATRIX_NORMAL] = rlGetLocationUniform(id, "matNormal");
+
+    shader.locs[SHADER_LOC_COLOR_DIFFUSE] = rlGetLocationUniform(id, "colDiffuse");
+    shader.locs[SHADER_LOC_MAP_DIFFUSE] = rlGetLocationUniform(id, "texture0");
+    shader.locs[SHADER_LOC_MAP_SPECULAR] = rlGetLocationUniform(id, "texture1");
+    shader.locs[SHADER_LOC_MAP_NORMAL] = rlGetLocationUniform(id, "texture2");
+
+    return shader;
+}
+
+// rlLoadShaderProgram() with the retrievable hint set before linking, which
+// some drivers need to return a binary at all
+static unsigned int
+link_retrievable(const char *vs, const char *fs)
+{
+    unsigned int vertex = rlCompileShader(vs, GL_VERTEX_SHADER);
+    unsigned int fragment = rlCompileShader(fs, GL_FRAGMENT_SHADER);
+    GLuint program = 0;
+
+    if (vertex != 0 && fragment != 0)
+    {
+        program = glCreateProgram();
+        shader_cache.program_parameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        glAttachShader(program, vertex);
+        glAttachShader(program, fragment);
+
+        glBindAttribLocation(program, 0, "vertexPosition");
+        glBindAttribLocation(program, 1, "vertexTexCoord");
+        glBindAttribLocation(program, 2, "vertexNormal");
+        glBindAttribLocation(program, 3, "vertexColor");
+        glBindAttribLocation(program, 4, "vertexTangent");
+        glBindAttribLocation(program, 5, "vertexTexCoord2");
+        glLinkProgram(program);
+
+        GLint linked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        glDetachShader(program, vertex);
+        glDetachShader(program, fragment);
+        if (linked == GL_FALSE)
+        {
+            glDeleteProgram(program);
+            program = 0;
+        }
+    }
+
+    if (vertex != 0)
+        glDeleteShader(vertex);
+    if (fragment != 0)
+        glDeleteShader(fragment);
+    return program;
+}
+
+static unsigned int
+load_binary(uint64_t key)
+{
+    std::FILE *file = std::fopen(cache_path(key).c_str(), "rb");
+    if (file == nullptr)
+        return 0;
+
+    ShaderCacheHeader header;
+    std::vector<unsigned char> binary;
+    bool valid = std::fread(&header, sizeof(header), 1, file) == 1
+        && header.magic == SHADER_CACHE_MAGIC
+        && header.version == SHADER_CACHE_VERSION
+        && header.key == key
+        && header.length > 0;
+    if (valid)
+    {
+        binary.resize(header.length);
+        valid = std::fread(binary.data(), 1, binary.size(), file) == binary.size();
+    }
+    std::fclose(file);
+    if (!valid)
+        return 0;
+
+    GLuint program = glCreateProgram();
+    shader_cache.program_binary(program, header.format, binary.data(), GLsizei(binary.size()));
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked == GL_FALSE)
+    {
+        glDeleteProgram(program);
+        std::remove(cache_path(key).c_str());
+        shader_cache.stats.rejected++;
+        TraceLog(LOG_INFO, "SHADER CACHE: [%016llx] Binary rejected by driver, recompiling",
+                 (unsigned long long) key);
+        return 0;
+    }
+
+    return program;
+}
+
+static void
+store_binary(uint64_t key, unsigned int program)
+{
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    std::vector<unsigned char> binary(length);
+    GLenum format = 0;
+    shader_cache.get_program_binary(program, length, &length, &format, binary.data());
+    if (length <= 0)
+        return;
+
+    std::error_code error;
+    std::filesystem::create_directories(shader_cache.directory, error);
+
+    ShaderCacheHeader header = {
+        SHADER_CACHE_MAGIC, SHADER_CACHE_VERSION, key, format, uint32_t(length)
+    };
+    std::string path = cache_path(key);
+    std::string temp_path = path + ".tmp";
+    std::FILE *file = std::fopen(temp_path.c_str(), "wb");
+    if (file == nullptr)
+        return;
+
+    bool written = std::fwrite(&header, sizeof(header), 1, file) == 1
+        && std::fwrite(binary.data(), 1, size_t(length), file) == size_t(length);
+    written = std::fclose(file) == 0 && written;
+
+    std::remove(path.c_str());
+    if (!written || std::rename(temp_path.c_str(), path.c_str()) != 0)
+        std::remove(temp_path.c_str());
+}
+
+Shader
+LoadShaderFromMemoryCached(const std::string &vsCode, const std::string &fsCode)
+{
+    PROFILE_FUNCTION();
+    const char *vs = vsCode.empty() ? nullptr : vsCode.c_str();
+    const char *fs = fsCode.empty() ? nullptr : fsCode.c_str();
+
+    if (!init_cache())
+        return LoadShaderFromMemory(vs, fs);
+
+    // The length prefix keeps "ab" + "c" and "a" + "bc" apart
+    uint64_t key = shader_cache.driver_hash;
+    key = hash_string(std::to_string(vsCode.size()) + ":" + vsCode, key);
+    key = hash_string(std::to_string(fsCode.size()) + ":" + fsCode, key);
+
+    unsigned int program = load_binary(key);
+    if (program > 0)
+    {
+        shader_cache.stats.hits++;
+        return make_shader(program);
+    }
+
+    shader_cache.stats.misses++;
+
+    // A missing stage takes raylib's default one, which only rlgl can attach
+    if (vs != nullptr && fs != nullptr && shader_cache.program_parameteri != nullptr)
+        program = link_retrievable(vs, fs);
+    else
+        program = rlLoadShaderCode(vs, fs);
+    if (program == 0 || program == rlGetShaderIdDefault())
+        return LoadShaderFromMemory(vs, fs);    // let raylib report and fall back
+
+    store_binary(key, program);
+    return make_shader(program);
+}
+
+Shader
+LoadShaderCached(const std::string &vsFileName, const std::string &fsFileName)
+{
+    PROFILE_FUNCTION();
+    std::string vsCode;
+    std::string fsCode;
+
+    for (auto [fileName, code] : { std::make_pair(&vsFileName, &vsCode),
+                                   std::make_pair(&fsFileName, &fsCode) })
+    {
+        if (fileName->empty())
+            continue;
+
+        char *text = LoadFileText(*fileName);
+        if (text == nullptr)
+            return LoadShader(vsFileName, fsFileName);
+        *code = text;
+        UnloadFileText(text);
+    }
+
+    return LoadShaderFromMemoryCached(vsCode, fsCode);
+}
+
+void
+SetShaderCacheDirectory(const std::string &directory)
+{
+    shader_cache.directory = directory;
+}
+
+ShaderCacheStats
+GetShaderCacheStats()
+{
+    return shader_cache.stats;
+}
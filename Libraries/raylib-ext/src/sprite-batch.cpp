@@ -0,0 +1,252 @@
+#include <raylib-ext/sprite-batch.hpp>
+
+#include <cmath>
+#include <cstring>
+
+#include "stream.hpp"
+
+#define SPRITE_BATCH_MAX_SLOTS 4096
+
+// Maps a float onto an unsigned integer with the same ordering
+static uint32_t
+depth_bits(float depth)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+}
+
+void
+SpriteBatch::begin()
+{
+    this->sprites.clear();
+    this->keys.clear();
+    this->textures.clear();
+    this->texture_slots.clear();
+    this->shaders.clear();
+    this->shader_slots.clear();
+
+    this->shaders.push_back(Shader { 0, nullptr });
+    this->shader_slots[0] = 0;
+    this->shader_slot = 0;
+
+    this->previous_state = UINT64_MAX;
+    this->unsorted_draws = 0;
+}
+
+void
+SpriteBatch::set_shader(Shader shader)
+{
+    auto found = this->shader_slots.find(shader.id);
+    if (found != this->shader_slots.end())
+    {
+        this->shader_slot = found->second;
+        return;
+    }
+
+    if ((int) this->shaders.size() >= SPRITE_BATCH_MAX_SLOTS)
+    {
+        TraceLog(LOG_WARNING, "SPRITEBATCH: Too many shaders in one frame, using default");
+        this->shader_slot = 0;
+        return;
+    }
+
+    this->shader_slot = (int) this->shaders.size();
+    this->shader_slots[shader.id] = this->shader_slot;
+    this->shaders.push_back(shader);
+}
+
+int
+SpriteBatch::texture_slot(unsigned int textureId)
+{
+    auto found = this->texture_slots.find(textureId);
+    if (found != this->texture_slots.end())
+        return found->second;
+
+    if ((int) this->textures.size() >= SPRITE_BATCH_MAX_SLOTS)
+        return -1;
+
+    int slot = (int) this->textures.size();
+    this->texture_slots[textureId] = slot;
+    this->textures.push_back(textureId);
+    return slot;
+}
+
+void
+SpriteBatch::draw(Texture2D texture, Vector2 position, Color tint, int layer, float depth)
+{
+    Rectangle source = { 0, 0, (float) texture.width, (float) texture.height };
+    Rectangle dest = { position.x, position.y, (float) texture.width, (float) texture.height };
+    draw(texture, source, dest, { 0, 0 }, 0.0f, tint, layer, depth);
+}
+
+// Same geometry and texture coordinates as DrawTexturePro()
+void
+SpriteBatch::draw(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin,
+                  float rotation, Color tint, int layer, float depth)
+{
+    if (texture.id == 0)
+        return;
+
+    int slot = texture_slot(texture.id);
+    if (slot < 0)
+    {
+        TraceLog(LOG_WARNING, "SPRITEBATCH: Too many textures in one frame, sprite skipped");
+        return;
+    }
+
+    float width = (float) texture.width;
+    float height = (float) texture.height;
+
+    bool flip_x = false;
+    if (source.width < 0)
+    {
+        flip_x = true;
+        source.width *= -1;
+    }
+    if (source.height < 0)
+        source.y -= source.height;
+
+    Sprite sprite;
+    sprite.tint = tint;
+    sprite.uv = flip_x
+        ? Rectangle { (source.x + source.width) / width, source.y / height,
+                      -source.width / width, source.height / height }
+        : Rectangle { source.x / width, source.y / height,
+                      source.width / width, source.height / height };
+
+    if (rotation == 0.0f)
+    {
+        float x = dest.x - origin.x;
+        float y = dest.y - origin.y;
+        sprite.corners[0] = { x, y };
+        sprite.corners[1] = { x, y + dest.height };
+        sprite.corners[2] = { x + dest.width, y + dest.height };
+        sprite.corners[3] = { x + dest.width, y };
+    }
+    else
+    {
+        float sin_r = std::sin(rotation * DEG2RAD);
+        float cos_r = std::cos(rotation * DEG2RAD);
+        float dx = -origin.x, dy = -origin.y;
+
+        auto corner = [&](float x, float y) {
+            return Vector2 { dest.x + x * cos_r - y * sin_r, dest.y + x * sin_r + y * cos_r };
+        };
+        sprite.corners[0] = corner(dx, dy);
+        sprite.corners[1] = corner(dx, dy + dest.height);
+        sprite.corners[2] = corner(dx + dest.width, dy + dest.height);
+        sprite.corners[3] = corner(dx + dest.width, dy);
+    }
+
+    layer = layer < -128 ? -128 : layer > 127 ? 127 : layer;
+    uint64_t state = (uint64_t(this->shader_slot) << 12) | uint64_t(slot);
+    uint64_t key = (uint64_t(layer + 128) << 56) | (state << 32) | depth_bits(depth);
+
+    if (state != this->previous_state)
+    {
+        this->unsorted_draws++;
+        this->previous_state = state;
+    }
+
+    this->sprites.push_back(sprite);
+    this->keys.push_back(key);
+}
+
+// Stable LSD radix sort of the keys, one byte per pass, carrying the
+// sprite indices along. Passes where every key has the same byte (often
+// most of the depth bits) are skipped.
+void
+SpriteBatch::sort()
+{
+    size_t count = this->keys.size();
+    this->order.resize(count);
+    this->scratch.resize(count);
+    this->key_scratch.resize(count);
+
+    for (size_t i = 0; i < count; ++i)
+        this->order[i] = (uint32_t) i;
+
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        size_t offsets[256] = {};
+        for (uint64_t key : this->keys)
+            offsets[(key >> shift) & 0xff]++;
+
+        if (offsets[(this->keys[0] >> shift) & 0xff] == count)
+            continue;
+
+        size_t total = 0;
+        for (size_t &offset : offsets)
+        {
+            size_t digits = offset;
+            offset = total;
+            total += digits;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t position = offsets[(this->keys[i] >> shift) & 0xff]++;
+            this->key_scratch[position] = this->keys[i];
+            this->scratch[position] = this->order[i];
+        }
+
+        this->keys.swap(this->key_scratch);
+        this->order.swap(this->scratch);
+    }
+}
+
+void
+SpriteBatch::end()
+{
+    SpriteBatchStats stats = {};
+    stats.sprites = (int) this->sprites.size();
+    stats.draw_calls_unsorted = this->unsorted_draws;
+    stats.textures = (int) this->textures.size();
+    stats.shaders = (int) this->shaders.size();
+
+    if (this->sprites.empty())
+    {
+        this->last_stats = stats;
+        return;
+    }
+
+    sort();
+
+    int count = (int) this->sprites.size();
+    StreamVertex *vertices = StreamReserve(count * 6);
+    int run_start = 0;
+
+    for (int i = 0; i < count; ++i)
+    {
+        const Sprite &sprite = this->sprites[this->order[i]];
+        const Rectangle &uv = sprite.uv;
+        StreamVertex *out = vertices + i * 6;
+
+        StreamVertex top_left = StreamMakeVertex(sprite.corners[0].x, sprite.corners[0].y,
+                                                 sprite.tint, uv.x, uv.y);
+        StreamVertex bottom_right = StreamMakeVertex(sprite.corners[2].x, sprite.corners[2].y,
+                                                     sprite.tint, uv.x + uv.width,
+                                                     uv.y + uv.height);
+        out[0] = top_left;
+        out[1] = StreamMakeVertex(sprite.corners[1].x, sprite.corners[1].y, sprite.tint,
+                                  uv.x, uv.y + uv.height);
+        out[2] = bottom_right;
+        out[3] = top_left;
+        out[4] = bottom_right;
+        out[5] = StreamMakeVertex(sprite.corners[3].x, sprite.corners[3].y, sprite.tint,
+                                  uv.x + uv.width, uv.y);
+
+        uint32_t state = uint32_t(this->keys[i] >> 32) & 0xffffff;
+        bool last = i + 1 == count || (uint32_t(this->keys[i + 1] >> 32) & 0xffffff) != state;
+        if (last)
+        {
+            StreamDraw(STREAM_TRIANGLES, vertices + run_start * 6, (i + 1 - run_start) * 6,
+                       this->textures[state & 0xfff], this->shaders[state >> 12]);
+            stats.draw_calls_sorted++;
+            run_start = i + 1;
+        }
+    }
+
+    this->last_stats = stats;
+}
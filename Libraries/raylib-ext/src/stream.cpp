@@ -0,0 +1,164 @@
+#include "stream.hpp"
+
+#include <cstddef>
+#include <vector>
+
+#include <glad/glad.h>
+
+// Multiple of 2 and 3 so chunks never split a line or a triangle
+#define STREAM_CHUNK_VERTICES (6 * 65536)
+
+struct Stream
+{
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    std::vector<StreamVertex> scratch;
+};
+
+static Stream stream;
+
+unsigned int
+StreamLoadVertexArray(unsigned int vbo)
+{
+    const int *locs = rlGetShaderLocsDefault();
+    const GLsizei stride = sizeof(StreamVertex);
+
+    GLuint vao = 0;
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+    glEnableVertexAttribArray(locs[SHADER_LOC_VERTEX_POSITION]);
+    glVertexAttribPointer(locs[SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, GL_FALSE,
+                          stride, (void *) offsetof(StreamVertex, x));
+    glEnableVertexAttribArray(locs[SHADER_LOC_VERTEX_TEXCOORD01]);
+    glVertexAttribPointer(locs[SHADER_LOC_VERTEX_TEXCOORD01], 2, GL_FLOAT, GL_FALSE,
+                          stride, (void *) offsetof(StreamVertex, u));
+    glEnableVertexAttribArray(locs[SHADER_LOC_VERTEX_COLOR]);
+    glVertexAttribPointer(locs[SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE,
+                          stride, (void *) offsetof(StreamVertex, r));
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return vao;
+}
+
+static void
+init_stream()
+{
+    glGenBuffers(1, &stream.vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, stream.vbo);
+    glBufferData(GL_ARRAY_BUFFER, STREAM_CHUNK_VERTICES * sizeof(StreamVertex),
+                 nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    stream.vao = StreamLoadVertexArray(stream.vbo);
+}
+
+Matrix
+StreamGetMatrixMVP()
+{
+    return MatrixMultiply(
+        MatrixMultiply(rlGetMatrixTransform(), rlGetMatrixModelview()),
+        rlGetMatrixProjection()
+    );
+}
+
+void
+StreamBeginShader(Shader shader, Matrix transform, Color tint)
+{
+    if (shader.id == 0 || shader.locs == nullptr)
+        shader = Shader { rlGetShaderIdDefault(), rlGetShaderLocsDefault() };
+
+    const int *locs = shader.locs;
+    Matrix mvp = MatrixMultiply(transform, StreamGetMatrixMVP());
+
+    glUseProgram(shader.id);
+    if (locs[SHADER_LOC_MATRIX_MVP] != -1)
+        glUniformMatrix4fv(locs[SHADER_LOC_MATRIX_MVP], 1, GL_FALSE, MatrixToFloat(mvp));
+    if (locs[SHADER_LOC_COLOR_DIFFUSE] != -1)
+        glUniform4f(locs[SHADER_LOC_COLOR_DIFFUSE], tint.r / 255.0f, tint.g / 255.0f,
+                    tint.b / 255.0f, tint.a / 255.0f);
+    if (locs[SHADER_LOC_MAP_DIFFUSE] != -1)
+        glUniform1i(locs[SHADER_LOC_MAP_DIFFUSE], 0);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void
+StreamEndShader()
+{
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUseProgram(0);
+}
+
+StreamVertex *
+StreamReserve(int count)
+{
+    if ((int) stream.scratch.size() < count)
+        stream.scratch.resize(count);
+    return stream.scratch.data();
+}
+
+void
+StreamDraw(StreamMode mode, const StreamVertex *vertices, int count,
+           unsigned int textureId, Shader shader)
+{
+    if (count <= 0)
+        return;
+
+    rlDrawRenderBatchActive();
+
+    if (stream.vao == 0)
+        init_stream();
+
+    StreamBeginShader(shader, MatrixIdentity(), WHITE);
+    glBindTexture(GL_TEXTURE_2D, textureId != 0 ? textureId : rlGetTextureIdDefault());
+
+    glBindVertexArray(stream.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, stream.vbo);
+
+    GLenum primitive = mode == STREAM_LINES ? GL_LINES : GL_TRIANGLES;
+    for (int first = 0; first < count; first += STREAM_CHUNK_VERTICES)
+    {
+        int chunk = count - first < STREAM_CHUNK_VERTICES
+            ? count - first : STREAM_CHUNK_VERTICES;
+
+        // Orphan the previous storage so the driver never stalls on a draw
+        // that is still reading it
+        glBufferData(GL_ARRAY_BUFFER, STREAM_CHUNK_VERTICES * sizeof(StreamVertex),
+                     nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, chunk * sizeof(StreamVertex), vertices + first);
+        glDrawArrays(primitive, 0, chunk);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    StreamEndShader();
+}
+
+/* Active batch stack */
+
+static std::vector<rlRenderBatch *> batch_stack;
+
+void
+PushRenderBatch(rlRenderBatch *batch)
+{
+    batch_stack.push_back(batch);
+    rlSetRenderBatchActive(batch);
+}
+
+void
+PopRenderBatch(rlRenderBatch *batch)
+{
+    for (size_t i = batch_stack.size(); i-- > 0;)
+    {
+        if (batch_stack[i] != batch)
+            continue;
+
+        bool top = i + 1 == batch_stack.size();
+        batch_stack.erase(batch_stack.begin() + i);
+        if (top)
+            rlSetRenderBatchActive(batch_stack.empty() ? nullptr : batch_stack.back());
+        return;
+    }
+}
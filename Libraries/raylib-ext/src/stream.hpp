@@ -0,0 +1,72 @@
+#ifndef RAYLIB_EXT_STREAM_HPP
+#define RAYLIB_EXT_STREAM_HPP
+
+#include <raylib-ext.hpp>
+
+/* Vertex streaming (private) */
+
+// Draws large vertex arrays outside of the rlgl batch. The active batch is
+// flushed first so ordering is kept, then the vertices are uploaded into an
+// orphaned stream buffer and drawn with the default shader, the current
+// modelview/projection/transform and the given texture (0 for the default
+// white texture). A shader with id 0 means the default shader; custom
+// shaders need raylib's default attribute and uniform names.
+
+struct StreamVertex
+{
+    float x, y, z;
+    float u, v;
+    unsigned char r, g, b, a;
+};
+
+enum StreamMode
+{
+    STREAM_LINES,
+    STREAM_TRIANGLES,
+};
+
+void
+StreamDraw(StreamMode mode, const StreamVertex *vertices, int count,
+           unsigned int textureId = 0, Shader shader = { 0, nullptr });
+
+// rlgl's model-view-projection for the current transform, the same one
+// rlDrawRenderBatch() and DrawMesh() upload
+Matrix
+StreamGetMatrixMVP();
+
+// Binds the shader (or the default one) with the current matrices
+// multiplied by transform, and colDiffuse set to tint. StreamEndShader()
+// unbinds.
+void
+StreamBeginShader(Shader shader, Matrix transform, Color tint);
+
+void
+StreamEndShader();
+
+// Vertex array reading StreamVertex data from vbo, laid out for the
+// default shader attribute locations
+unsigned int
+StreamLoadVertexArray(unsigned int vbo);
+
+// Scratch storage reused between calls, grown on demand.
+StreamVertex *
+StreamReserve(int count);
+
+inline StreamVertex
+StreamMakeVertex(float x, float y, Color color, float u = 0.0f, float v = 0.0f)
+{
+    return StreamVertex { x, y, 0.0f, u, v, color.r, color.g, color.b, color.a };
+}
+
+/* Active batch stack */
+
+// rlgl can't tell which batch is active, so modules that swap their own
+// batch in go through these. PopRenderBatch() removes the given batch and
+// reactivates whatever is on top, or the default batch.
+void
+PushRenderBatch(rlRenderBatch *batch);
+
+void
+PopRenderBatch(rlRenderBatch *batch);
+
+#endif // RAYLIB_EXT_STREAM_HPP
@@ -0,0 +1,322 @@
+#include <raylib-ext/tessellation.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Largest gap in pixels between an arc and its chords, as raylib's
+// SMOOTH_CIRCLE_ERROR_RATE
+#define TESSELLATION_ERROR_RATE   0.5f
+#define TESSELLATION_MIN_SEGMENTS 8
+#define TESSELLATION_MAX_SEGMENTS 512
+#define TESSELLATION_SEGMENT_STEP 4
+#define TESSELLATION_MAX_SHAPES   1024
+
+enum ShapeType
+{
+    SHAPE_CIRCLE,
+    SHAPE_RING,
+    SHAPE_ROUNDED_RECTANGLE,
+    SHAPE_POLY,
+};
+
+struct ShapeKey
+{
+    int type;
+    int segments;
+    float a, b, c;
+
+    bool operator==(const ShapeKey &other) const
+    {
+        return this->type == other.type && this->segments == other.segments
+            && this->a == other.a && this->b == other.b && this->c == other.c;
+    }
+};
+
+struct ShapeKeyHash
+{
+    size_t operator()(const ShapeKey &key) const
+    {
+        uint64_t hash = 14695981039346656037ull;
+        const unsigned char *bytes = (const unsigned char *) &key;
+        for (size_t i = 0; i < sizeof(ShapeKey); ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return (size_t) hash;
+    }
+};
+
+struct Tessellation
+{
+    std::unordered_map<ShapeKey, std::vector<Vector2>, ShapeKeyHash> shapes;
+    TessellationCacheStats stats = {};
+};
+
+static Tessellation tessellation;
+
+// Keys are hashed bytewise, so padding and -0.0f must not leak in
+static ShapeKey
+make_key(int type, int segments, float a = 0.0f, float b = 0.0f, float c = 0.0f)
+{
+    ShapeKey key;
+    std::memset(&key, 0, sizeof(key));
+    key.type = type;
+    key.segments = segments;
+    key.a = a + 0.0f;
+    key.b = b + 0.0f;
+    key.c = c + 0.0f;
+    return key;
+}
+
+// Largest axis scale of the current transform and camera
+static float
+screen_scale()
+{
+    Matrix m = MatrixMultiply(rlGetMatrixTransform(), rlGetMatrixModelview());
+    float sx = std::sqrt(m.m0 * m.m0 + m.m1 * m.m1);
+    float sy = std::sqrt(m.m4 * m.m4 + m.m5 * m.m5);
+    return sx > sy ? sx : sy;
+}
+
+int
+GetCircleSegments(float radius)
+{
+    if (radius <= TESSELLATION_ERROR_RATE)
+        return TESSELLATION_MIN_SEGMENTS;
+
+    float ratio = 1.0f - TESSELLATION_ERROR_RATE / radius;
+    float theta = std::acos(2.0f * ratio * ratio - 1.0f);
+    int segments = (int) std::ceil(2.0f * PI / theta);
+
+    segments = (segments + TESSELLATION_SEGMENT_STEP - 1)
+        / TESSELLATION_SEGMENT_STEP * TESSELLATION_SEGMENT_STEP;
+    if (segments < TESSELLATION_MIN_SEGMENTS)
+        segments = TESSELLATION_MIN_SEGMENTS;
+    if (segments > TESSELLATION_MAX_SEGMENTS)
+        segments = TESSELLATION_MAX_SEGMENTS;
+    return segments;
+}
+
+static int
+adaptive_segments(float radius, float fraction)
+{
+    int segments = (int) std::ceil(GetCircleSegments(radius * screen_scale()) * fraction);
+    return segments > 0 ? segments : 1;
+}
+
+// Same angle convention as the raylib shape functions: 0 degrees points
+// down (+y) and angles grow towards +x
+static Vector2
+unit_point(float degrees)
+{
+    return Vector2 { std::sin(DEG2RAD * degrees), std::cos(DEG2RAD * degrees) };
+}
+
+static const std::vector<Vector2> &
+find_or_build(const ShapeKey &key, void (*build)(const ShapeKey &, std::vector<Vector2> &))
+{
+    auto found = tessellation.shapes.find(key);
+    if (found != tessellation.shapes.end())
+    {
+        tessellation.stats.hits++;
+        return found->second;
+    }
+
+    tessellation.stats.misses++;
+    if (tessellation.shapes.size() >= TESSELLATION_MAX_SHAPES)
+        tessellation.shapes.clear();
+
+    std::vector<Vector2> &vertices = tessellation.shapes[key];
+    build(key, vertices);
+    return vertices;
+}
+
+// Scales, then rotates by degrees, then translates
+static void
+emit(const std::vector<Vector2> &vertices, Vector2 offset, Vector2 scale, Color color,
+     float rotation = 0.0f)
+{
+    float s = rotation != 0.0f ? std::sin(DEG2RAD * rotation) : 0.0f;
+    float c = rotation != 0.0f ? std::cos(DEG2RAD * rotation) : 1.0f;
+
+    rlCheckRenderBatchLimit((int) vertices.size());
+
+    rlBegin(RL_TRIANGLES);
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    for (const Vector2 &v : vertices)
+    {
+        float x = v.x * scale.x;
+        float y = v.y * scale.y;
+        rlVertex2f(offset.x + x * c - y * s, offset.y + x * s + y * c);
+    }
+    rlEnd();
+}
+
+/* Builders */
+
+static void
+build_circle(const ShapeKey &key, std::vector<Vector2> &vertices)
+{
+    float step = 360.0f / key.segments;
+    for (int i = 0; i < key.segments; ++i)
+    {
+        vertices.push_back(Vector2 { 0.0f, 0.0f });
+        vertices.push_back(unit_point(step * i));
+        vertices.push_back(unit_point(step * (i + 1)));
+    }
+}
+
+// a = inner/outer ratio, b = start angle, c = end angle; outer radius 1
+static void
+build_ring(const ShapeKey &key, std::vector<Vector2> &vertices)
+{
+    float step = (key.c - key.b) / key.segments;
+    for (int i = 0; i < key.segments; ++i)
+    {
+        Vector2 p0 = unit_point(key.b + step * i);
+        Vector2 p1 = unit_point(key.b + step * (i + 1));
+
+        vertices.push_back(p0 * key.a);
+        vertices.push_back(p0);
+        vertices.push_back(p1 * key.a);
+        vertices.push_back(p1 * key.a);
+        vertices.push_back(p0);
+        vertices.push_back(p1);
+    }
+}
+
+// The four corner arcs of a rounded rectangle, radius 1 around their own
+// corner center: top-right, top-left, bottom-left, bottom-right, each with
+// segments + 1 points. Corners keep their shape at any width and height,
+// so only the segment count is part of the key.
+static void
+build_rounded_corners(const ShapeKey &key, std::vector<Vector2> &vertices)
+{
+    for (int corner = 0; corner < 4; ++corner)
+    {
+        for (int i = 0; i <= key.segments; ++i)
+        {
+            float theta = -0.5f * PI * (corner + float(i) / key.segments);
+            vertices.push_back(Vector2 { std::cos(theta), std::sin(theta) });
+        }
+    }
+}
+
+// segments = sides; radius 1, rotated when emitted
+static void
+build_poly(const ShapeKey &key, std::vector<Vector2> &vertices)
+{
+    float step = 360.0f / key.segments;
+    for (int i = 0; i < key.segments; ++i)
+    {
+        vertices.push_back(Vector2 { 0.0f, 0.0f });
+        vertices.push_back(unit_point(step * i));
+        vertices.push_back(unit_point(step * (i + 1)));
+    }
+}
+
+/* Public API */
+
+void
+DrawCircleCached(Vector2 center, float radius, Color color)
+{
+    ShapeKey key = make_key(SHAPE_CIRCLE, adaptive_segments(radius, 1.0f));
+    emit(find_or_build(key, build_circle), center, { radius, radius }, color);
+}
+
+void
+DrawRingCached(Vector2 center, float innerRadius, float outerRadius,
+               float startAngle, float endAngle, int segments, Color color)
+{
+    if (startAngle == endAngle)
+        return;
+
+    if (startAngle > endAngle)
+        std::swap(startAngle, endAngle);
+    if (innerRadius > outerRadius)
+        std::swap(innerRadius, outerRadius);
+    if (outerRadius <= 0.0f)
+        outerRadius = 0.1f;
+
+    if (segments <= 0)
+        segments = adaptive_segments(outerRadius, (endAngle - startAngle) / 360.0f);
+
+    ShapeKey key = make_key(SHAPE_RING, segments, innerRadius / outerRadius,
+                            startAngle, endAngle);
+    emit(find_or_build(key, build_ring), center, { outerRadius, outerRadius }, color);
+}
+
+void
+DrawRectangleRoundedCached(Rectangle rec, float roundness, int segments, Color color)
+{
+    if (roundness <= 0.0f || rec.width < 1 || rec.height < 1)
+    {
+        DrawRectangleRec(rec, color);
+        return;
+    }
+
+    if (roundness > 1.0f)
+        roundness = 1.0f;
+
+    float radius = (rec.width > rec.height ? rec.height : rec.width) * roundness / 2.0f;
+    if (segments <= 0)
+        segments = adaptive_segments(radius, 0.25f);
+
+    // The outline runs counterclockwise on screen and is fanned from the
+    // center
+    ShapeKey key = make_key(SHAPE_ROUNDED_RECTANGLE, segments);
+    const std::vector<Vector2> &corners = find_or_build(key, build_rounded_corners);
+    const Vector2 centers[4] = {
+        { rec.x + rec.width - radius, rec.y + radius },
+        { rec.x + radius, rec.y + radius },
+        { rec.x + radius, rec.y + rec.height - radius },
+        { rec.x + rec.width - radius, rec.y + rec.height - radius },
+    };
+    const Vector2 center = { rec.x + rec.width * 0.5f, rec.y + rec.height * 0.5f };
+    const int per_corner = segments + 1;
+    const int count = (int) corners.size();
+
+    rlCheckRenderBatchLimit(count * 3);
+
+    rlBegin(RL_TRIANGLES);
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    Vector2 previous = centers[3] + corners[count - 1] * radius;
+    for (int i = 0; i < count; ++i)
+    {
+        Vector2 point = centers[i / per_corner] + corners[i] * radius;
+        rlVertex2f(center.x, center.y);
+        rlVertex2f(previous.x, previous.y);
+        rlVertex2f(point.x, point.y);
+        previous = point;
+    }
+    rlEnd();
+}
+
+void
+DrawPolyCached(Vector2 center, int sides, float radius, float rotation, Color color)
+{
+    if (sides < 3)
+        sides = 3;
+
+    ShapeKey key = make_key(SHAPE_POLY, sides);
+    emit(find_or_build(key, build_poly), center, { radius, radius }, color, rotation);
+}
+
+TessellationCacheStats
+GetTessellationCacheStats()
+{
+    TessellationCacheStats stats = tessellation.stats;
+    stats.shapes = (int) tessellation.shapes.size();
+    return stats;
+}
+
+void
+ClearTessellationCache()
+{
+    tessellation.shapes.clear();
+    tessellation.stats = {};
+}
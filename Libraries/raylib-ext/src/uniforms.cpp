@@ -0,0 +1,178 @@
+#include <raylib-ext/uniforms.hpp>
+#include <raylib-ext/frame.hpp>
+
+#include <cstring>
+
+struct UniformStatsState
+{
+    UniformStats current = {};
+    UniformStats last = {};
+    bool registered = false;
+};
+
+static UniformStatsState uniform_stats;
+
+// Frame end callback: the frame's counters become the ones reported
+static void
+end_uniform_stats_frame(void *)
+{
+    uniform_stats.last = uniform_stats.current;
+    uniform_stats.current = {};
+}
+
+static size_t
+uniform_size(int uniformType)
+{
+    switch (uniformType)
+    {
+    case SHADER_UNIFORM_FLOAT: return sizeof(float);
+    case SHADER_UNIFORM_VEC2: return sizeof(float) * 2;
+    case SHADER_UNIFORM_VEC3: return sizeof(float) * 3;
+    case SHADER_UNIFORM_VEC4: return sizeof(float) * 4;
+    case SHADER_UNIFORM_INT: return sizeof(int);
+    case SHADER_UNIFORM_IVEC2: return sizeof(int) * 2;
+    case SHADER_UNIFORM_IVEC3: return sizeof(int) * 3;
+    case SHADER_UNIFORM_IVEC4: return sizeof(int) * 4;
+    case SHADER_UNIFORM_SAMPLER2D: return sizeof(int);
+    default: return 0;
+    }
+}
+
+ShaderUniforms::ShaderUniforms(Shader shader) :
+    shader(shader)
+{
+    // The stats are global, the first table starts the per frame counting
+    if (!uniform_stats.registered)
+    {
+        AddFrameEndCallback(end_uniform_stats_frame, nullptr);
+        uniform_stats.registered = true;
+    }
+}
+
+int
+ShaderUniforms::add(const std::string &name, int uniformType, int count)
+{
+    uint32_t hash = HashUniformName(name.c_str());
+    for (size_t i = 0; i < this->uniforms.size(); ++i)
+    {
+        if (this->uniforms[i].hash != hash)
+            continue;
+        if (this->uniforms[i].name == name)
+            return int(i);
+
+        // Still gets its own slot, but set() by hash reaches the first one
+        TraceLog(LOG_WARNING, "SHADER: [ID %i] Uniforms \"%s\" and \"%s\" have the same hash, "
+                 "set \"%s\" by slot", this->shader.id, this->uniforms[i].name.c_str(),
+                 name.c_str(), name.c_str());
+    }
+
+    Uniform uniform;
+    uniform.name = name;
+    uniform.hash = hash;
+    uniform.location = GetShaderLocation(this->shader, name);
+    uniform.type = uniformType;
+    uniform.count = count;
+    uniform.offset = this->block.size();
+    uniform.size = uniform_size(uniformType) * count;
+    uniform.dirty = false;
+    uniform.staged = false;
+
+    if (uniform.location < 0)
+        TraceLog(LOG_WARNING, "SHADER: [ID %i] Uniform \"%s\" not found",
+                 this->shader.id, name.c_str());
+
+    this->block.resize(this->block.size() + uniform.size);
+    this->uniforms.push_back(uniform);
+    return int(this->uniforms.size()) - 1;
+}
+
+int
+ShaderUniforms::find(uint32_t nameHash) const
+{
+    for (size_t i = 0; i < this->uniforms.size(); ++i)
+    {
+        if (this->uniforms[i].hash == nameHash)
+            return int(i);
+    }
+    return -1;
+}
+
+void
+ShaderUniforms::set(int slot, const void *value)
+{
+    if (slot < 0 || slot >= int(this->uniforms.size()))
+        return;
+
+    Uniform &uniform = this->uniforms[slot];
+    unsigned char *staged = this->block.data() + uniform.offset;
+    uniform_stats.current.sets++;
+
+    // The block starts zeroed, not at the shader's initial value, so the
+    // first value is always uploaded
+    if (uniform.staged && std::memcmp(staged, value, uniform.size) == 0)
+    {
+        uniform_stats.current.unchanged++;
+        return;
+    }
+
+    std::memcpy(staged, value, uniform.size);
+    uniform.staged = true;
+    uniform.dirty = true;
+}
+
+void
+ShaderUniforms::set(uint32_t nameHash, const void *value)
+{
+    set(find(nameHash), value);
+}
+
+void
+ShaderUniforms::apply()
+{
+    bool bound = false;
+    for (Uniform &uniform : this->uniforms)
+    {
+        if (!uniform.dirty)
+            continue;
+        uniform.dirty = false;
+        if (uniform.location < 0)
+            continue;
+
+        if (!bound)
+        {
+            rlEnableShader(this->shader.id);
+            uniform_stats.current.applies++;
+            uniform_stats.current.gl_calls++;
+            bound = true;
+        }
+        rlSetUniform(uniform.location, this->block.data() + uniform.offset,
+                     uniform.type, uniform.count);
+        uniform_stats.current.uploads++;
+        uniform_stats.current.gl_calls++;
+    }
+}
+
+// Marks every staged value for upload, e.g. after the program was relinked
+void
+ShaderUniforms::invalidate()
+{
+    for (Uniform &uniform : this->uniforms)
+        uniform.dirty = uniform.staged;
+}
+
+UniformStats
+GetUniformStats()
+{
+    UniformStats stats = uniform_stats.last;
+    // Without the table every set() is glGetUniformLocation + glUseProgram
+    // + glUniform*
+    stats.gl_calls_saved = stats.sets * 3 - stats.gl_calls;
+    return stats;
+}
+
+void
+ResetUniformStats()
+{
+    uniform_stats.current = {};
+    uniform_stats.last = {};
+}
@@ -0,0 +1,60 @@
+#include <softraster.hpp>
+#include <raylib-ext/bench.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+// A times-table frame scaled to the canvas
+static void
+draw_frame(Canvas &canvas, int lines, float multiple)
+{
+    const float radius = std::min(canvas.width, canvas.height) * 0.5f - 10;
+    const Vector2 center = { canvas.width * 0.5f, canvas.height * 0.5f };
+    const float theta = 2.0f * PI / lines;
+    const Color color = ColorFromHSV(multiple * 50.0f, 1, 1);
+
+    canvas.clear(BLACK);
+    canvas.ring(center, radius + 1, radius + 3, color);
+
+    for (int n = 0; n < lines; ++n)
+    {
+        Vector2 start = Vector2 { std::cos(theta * n), std::sin(theta * n) } * radius + center;
+        Vector2 end = Vector2 {
+            std::cos(theta * multiple * n), std::sin(theta * multiple * n)
+        } * radius + center;
+        canvas.line(start, end, 1.5f, color);
+    }
+
+    canvas.flush();
+}
+
+// Usage: bench-softraster [size] [lines]
+int main(int argc, char **argv)
+{
+    const int size = argc > 1 ? std::atoi(argv[1]) : 2048;
+    const int lines = argc > 2 ? std::atoi(argv[2]) : 2000;
+    const int frames = 10;
+
+    double single = 0.0;
+
+    for (int threads : BenchThreadCounts())
+    {
+        Canvas canvas(size, size, threads);
+        draw_frame(canvas, lines, 2.0f);
+
+        double start = BenchNowMs();
+        for (int frame = 0; frame < frames; ++frame)
+            draw_frame(canvas, lines, 2.0f + frame * 0.01f);
+        double frame_ms = (BenchNowMs() - start) / frames;
+
+        if (threads == 1)
+            single = frame_ms;
+
+        std::printf("threads %2d   %dx%d   %d lines   %8.2f ms/frame (%4.1fx)\n",
+                    threads, size, size, lines, frame_ms, single / frame_ms);
+    }
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+#ifndef SOFTRASTER_HPP
+#define SOFTRASTER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <raylib-ext.hpp>
+
+/* Canvas font */
+
+// Glyph atlas kept in CPU memory, so text can be drawn without a GL
+// context. Glyph metrics follow raylib's Font.
+struct CanvasFont
+{
+    int base_size;
+    int glyph_padding;
+    int atlas_width;
+    int atlas_height;
+    std::vector<unsigned char> coverage;    // atlas alpha, one byte per pixel
+    std::vector<GlyphInfo> glyphs;          // image fields are left empty
+    std::vector<Rectangle> recs;
+
+    // Rasterizes a TTF/OTF file, CPU only
+    CanvasFont(const char *fileName, int fontSize);
+    // Reads the atlas of a loaded font back from the GPU, e.g. GetFontDefault()
+    CanvasFont(Font font);
+
+    int glyph_index(int codepoint) const;
+    // Same as MeasureTextEx()
+    Vector2 measure(const char *text, float font_size, float spacing) const;
+
+private:
+    int ascii[128];
+
+    void index_glyphs();
+};
+
+/* Canvas */
+
+// Software rasterizer for the drawing subset our sketches use. Primitives
+// are recorded and binned into 64x64 tiles; flush() rasterizes the tiles in
+// parallel, each one walking its primitives in submission order, so the
+// result does not depend on the thread count.
+//
+// Coverage is evaluated 4 pixels at a time from edge/distance functions
+// (SSE2 when available), which gives anti-aliased edges for free.
+struct Canvas
+{
+    int width;
+    int height;
+    std::vector<Color> pixels;  // RGBA8, top row first
+
+    // threads = 0 uses every hardware thread
+    Canvas(int width, int height, int threads = 0);
+    Canvas(const Canvas &) = delete;
+    Canvas& operator=(const Canvas &) = delete;
+    ~Canvas();
+
+    void clear(Color color);
+    // One pixel wide and aliased, like DrawLine()
+    void line(Vector2 start, Vector2 end, Color color);
+    // Anti-aliased with butt caps, like DrawLineEx()
+    void line(Vector2 start, Vector2 end, float thick, Color color);
+    void circle(Vector2 center, float radius, Color color);
+    void ring(Vector2 center, float inner_radius, float outer_radius, Color color);
+    void rectangle(Rectangle rec, Color color);
+    // Same layout as DrawTextEx()
+    void text(const CanvasFont &font, const char *text, Vector2 position,
+              float font_size, float spacing, Color color);
+
+    // Rasterizes everything recorded since the last flush into pixels
+    void flush();
+    // Flushes and returns a copy to be released with UnloadImage()
+    Image to_image();
+    int thread_count() const;
+
+private:
+    struct Primitive
+    {
+        int type;
+        Color color;
+        int x0, y0, x1, y1;     // pixel bounds, exclusive max
+        float p[8];
+        const CanvasFont *font;
+    };
+
+    int tiles_x;
+    int tiles_y;
+    std::vector<Primitive> primitives;
+    std::vector<std::vector<uint32_t>> bins;
+    bool cleared;
+    Color clear_color;
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable work_cv;
+    std::condition_variable done_cv;
+    std::atomic<int> next_tile;
+    uint64_t generation;
+    int busy;
+    bool stopping;
+
+    void submit(Primitive &primitive, float x0, float y0, float x1, float y1);
+    bool touches(const Primitive &primitive, int tile_x, int tile_y) const;
+    void rasterize_tiles();
+    void rasterize_tile(int tile);
+    void worker_loop();
+};
+
+#endif // SOFTRASTER_HPP
@@ -0,0 +1,36 @@
+#ifndef SOFTRASTER_OFFLINE_HPP
+#define SOFTRASTER_OFFLINE_HPP
+
+#include <functional>
+#include <string>
+#include <softraster.hpp>
+#include <raylib-ext/capture.hpp>
+
+/* Offline rendering */
+
+struct OfflineStats
+{
+    int frames;                 // frames rendered and written
+    int failed;                 // frames that could not be written
+    int threads;
+    double seconds;
+    double frames_per_second;
+};
+
+// Renders frames [first, first + count) of a sketch whose frames depend
+// only on their index into directory/frame-NNNNNN.<ext>, the same naming
+// FrameCapture uses, so the sequence is ordered however the work is split.
+//
+// Workers take ranges of `chunk` consecutive frames; each one renders into
+// its own single threaded Canvas and encodes its own files, so throughput
+// scales with cores. render() is called from several threads at once and
+// must not touch shared state. No GL context is needed.
+//
+// threads <= 0 uses every hardware thread.
+OfflineStats
+render_offline(const std::function<void(int frame, Canvas &canvas)> &render,
+               int first, int count, int width, int height,
+               const std::string &directory, CaptureFormat format = CAPTURE_PNG,
+               int threads = 0, int chunk = 4);
+
+#endif // SOFTRASTER_OFFLINE_HPP
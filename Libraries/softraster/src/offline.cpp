@@ -0,0 +1,98 @@
+#include <softraster/offline.hpp>
+#include <raylib-ext/image-export.hpp>
+#include <raylib-ext/profiler.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+static bool
+write_frame(Canvas &canvas, const std::string &directory, CaptureFormat format, int frame)
+{
+    PROFILE_FUNCTION();
+
+    static const char *extensions[] = { ".png", ".qoi", ".raw" };
+    char name[32];
+    std::snprintf(name, sizeof(name), "/frame-%06d", frame);
+
+    // Frames are already encoded in parallel, one per worker
+    Image image = {
+        canvas.pixels.data(), canvas.width, canvas.height, 1,
+        PIXELFORMAT_UNCOMPRESSED_R8G8B8A8
+    };
+    return ExportImageParallel(image, directory + name + extensions[format], 1);
+}
+
+OfflineStats
+render_offline(const std::function<void(int frame, Canvas &canvas)> &render,
+               int first, int count, int width, int height,
+               const std::string &directory, CaptureFormat format,
+               int threads, int chunk)
+{
+    OfflineStats stats = {};
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error)
+    {
+        TraceLog(LOG_WARNING, "SOFTRASTER: [%s] Failed to create directory", directory.c_str());
+        stats.failed = count;
+        return stats;
+    }
+
+    if (threads <= 0)
+        threads = std::max(1, (int) std::thread::hardware_concurrency());
+    chunk = std::max(chunk, 1);
+    threads = std::max(1, std::min(threads, (count + chunk - 1) / chunk));
+
+    std::atomic<int> next(0);
+    std::atomic<int> written(0);
+    std::atomic<int> failed(0);
+
+    auto work = [&] {
+        // Tiles are not split further, the frames already keep every core busy
+        Canvas canvas(width, height, 1);
+
+        for (int begin; (begin = next.fetch_add(chunk)) < count;)
+        {
+            int end = std::min(begin + chunk, count);
+            for (int frame = first + begin; frame < first + end; ++frame)
+            {
+                PROFILE_SCOPE("Offline frame");
+
+                render(frame, canvas);
+                canvas.flush();
+
+                if (write_frame(canvas, directory, format, frame))
+                    ++written;
+                else
+                    ++failed;
+            }
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < threads; ++i)
+        workers.emplace_back([&] {
+            PROFILE_THREAD("offline worker");
+            work();
+        });
+    work();
+    for (std::thread &worker : workers)
+        worker.join();
+
+    stats.seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start
+    ).count();
+    stats.frames = written;
+    stats.failed = failed;
+    stats.threads = threads;
+    stats.frames_per_second = stats.seconds > 0.0 ? stats.frames / stats.seconds : 0.0;
+    return stats;
+}
@@ -0,0 +1,889 @@
+#include <softraster.hpp>
+#include <raylib-ext/profiler.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOFTRASTER_SSE2
+#endif
+
+#define TILE_SIZE 64
+
+/* Four lanes of floats */
+
+// Comparisons return masks that may only be combined with & and finally
+// and-ed with f4(1.0f) to turn them into 0/1 coverage
+
+#ifdef SOFTRASTER_SSE2
+
+struct F4 { __m128 v; };
+
+static inline F4 f4(float f) { return { _mm_set1_ps(f) }; }
+static inline F4 f4_lanes(float x) { return { _mm_setr_ps(x, x + 1, x + 2, x + 3) }; }
+static inline F4 operator+(F4 a, F4 b) { return { _mm_add_ps(a.v, b.v) }; }
+static inline F4 operator-(F4 a, F4 b) { return { _mm_sub_ps(a.v, b.v) }; }
+static inline F4 operator*(F4 a, F4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+static inline F4 operator&(F4 a, F4 b) { return { _mm_and_ps(a.v, b.v) }; }
+static inline F4 min4(F4 a, F4 b) { return { _mm_min_ps(a.v, b.v) }; }
+static inline F4 max4(F4 a, F4 b) { return { _mm_max_ps(a.v, b.v) }; }
+static inline F4 sqrt4(F4 a) { return { _mm_sqrt_ps(a.v) }; }
+static inline F4 abs4(F4 a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+static inline F4 gt(F4 a, F4 b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+static inline F4 ge(F4 a, F4 b) { return { _mm_cmpge_ps(a.v, b.v) }; }
+static inline F4 lt(F4 a, F4 b) { return { _mm_cmplt_ps(a.v, b.v) }; }
+static inline F4 le(F4 a, F4 b) { return { _mm_cmple_ps(a.v, b.v) }; }
+static inline void store(float *out, F4 a) { _mm_storeu_ps(out, a.v); }
+
+#else
+
+struct F4 { float v[4]; };
+
+#define F4_MAP(expr) F4 r; for (int i = 0; i < 4; ++i) r.v[i] = (expr); return r;
+
+static inline F4 f4(float f) { F4_MAP(f) }
+static inline F4 f4_lanes(float x) { F4_MAP(x + i) }
+static inline F4 operator+(F4 a, F4 b) { F4_MAP(a.v[i] + b.v[i]) }
+static inline F4 operator-(F4 a, F4 b) { F4_MAP(a.v[i] - b.v[i]) }
+static inline F4 operator*(F4 a, F4 b) { F4_MAP(a.v[i] * b.v[i]) }
+static inline F4 operator&(F4 a, F4 b) { F4_MAP(a.v[i] * b.v[i]) }
+static inline F4 min4(F4 a, F4 b) { F4_MAP(std::min(a.v[i], b.v[i])) }
+static inline F4 max4(F4 a, F4 b) { F4_MAP(std::max(a.v[i], b.v[i])) }
+static inline F4 sqrt4(F4 a) { F4_MAP(std::sqrt(a.v[i])) }
+static inline F4 abs4(F4 a) { F4_MAP(std::fabs(a.v[i])) }
+static inline F4 gt(F4 a, F4 b) { F4_MAP(a.v[i] > b.v[i] ? 1.0f : 0.0f) }
+static inline F4 ge(F4 a, F4 b) { F4_MAP(a.v[i] >= b.v[i] ? 1.0f : 0.0f) }
+static inline F4 lt(F4 a, F4 b) { F4_MAP(a.v[i] < b.v[i] ? 1.0f : 0.0f) }
+static inline F4 le(F4 a, F4 b) { F4_MAP(a.v[i] <= b.v[i] ? 1.0f : 0.0f) }
+static inline void store(float *out, F4 a) { std::memcpy(out, a.v, sizeof(a.v)); }
+
+#undef F4_MAP
+
+#endif
+
+static inline F4 clamp01(F4 a) { return min4(max4(a, f4(0.0f)), f4(1.0f)); }
+
+/* Primitives */
+
+enum PrimitiveType
+{
+    PRIM_LINE,      // ax, ay, ux, uy, length, half width, 1/ux, 1/uy
+    PRIM_LINE_AA,   // same as PRIM_LINE
+    PRIM_CIRCLE,    // cx, cy, radius
+    PRIM_RING,      // cx, cy, inner radius, outer radius
+    PRIM_RECT,      // x0, y0, x1, y1
+    PRIM_GLYPH,     // dst x, dst y, src x, src y, src w, src h, scale x, scale y
+};
+
+static inline F4
+coverage(const float *p, int type, float x, float py)
+{
+    F4 px = f4_lanes(x + 0.5f);
+
+    switch (type)
+    {
+    case PRIM_LINE:
+    case PRIM_LINE_AA:
+    {
+        F4 dx = px - f4(p[0]);
+        F4 dy = f4(py - p[1]);
+        F4 perp = dy * f4(p[2]) - dx * f4(p[3]);
+        F4 along = dx * f4(p[2]) + dy * f4(p[3]);
+
+        if (type == PRIM_LINE)
+        {
+            // Exactly one pixel per step along the major axis
+            return gt(perp, f4(-p[5])) & le(perp, f4(p[5]))
+                 & ge(along, f4(0.0f)) & lt(along, f4(p[4])) & f4(1.0f);
+        }
+
+        return clamp01(f4(p[5] + 0.5f) - abs4(perp))
+             * clamp01(min4(along, f4(p[4]) - along) + f4(0.5f));
+    }
+    case PRIM_CIRCLE:
+    case PRIM_RING:
+    {
+        F4 dx = px - f4(p[0]);
+        F4 dy = f4(py - p[1]);
+        F4 d = sqrt4(dx * dx + dy * dy);
+
+        if (type == PRIM_CIRCLE)
+            return clamp01(f4(p[2] + 0.5f) - d);
+
+        return min4(clamp01(f4(p[3] + 0.5f) - d), clamp01(d - f4(p[2] - 0.5f)));
+    }
+    case PRIM_RECT:
+    {
+        F4 cx = clamp01(min4(px - f4(p[0]), f4(p[2]) - px) + f4(0.5f));
+        float cy = std::min(py - p[1], p[3] - py) + 0.5f;
+        return cx * f4(std::min(std::max(cy, 0.0f), 1.0f));
+    }
+    }
+
+    return f4(0.0f);
+}
+
+// Horizontal spans of the row at py that the primitive may cover, as
+// pixel center ranges; at most two (rings skip their hole)
+static int
+row_spans(const float *p, int type, float py, float *spans)
+{
+    switch (type)
+    {
+    case PRIM_LINE:
+    case PRIM_LINE_AA:
+    {
+        float r = type == PRIM_LINE ? p[5] : p[5] + 0.5f;
+        float lo = -INFINITY, hi = INFINITY;
+
+        // |perp| <= r, perp = (py - ay)*ux - (px - ax)*uy
+        float c1 = (py - p[1]) * p[2] + p[0] * p[3];
+        if (p[3] != 0.0f)
+        {
+            float a = (c1 - r) * p[7], b = (c1 + r) * p[7];
+            lo = std::max(lo, std::min(a, b));
+            hi = std::min(hi, std::max(a, b));
+        }
+        else if (std::fabs(c1) > r)
+            return 0;
+
+        // -0.5 <= along <= length + 0.5, along = (px - ax)*ux + (py - ay)*uy
+        float c2 = (py - p[1]) * p[3] - p[0] * p[2];
+        if (p[2] != 0.0f)
+        {
+            float a = (-0.5f - c2) * p[6], b = (p[4] + 0.5f - c2) * p[6];
+            lo = std::max(lo, std::min(a, b));
+            hi = std::min(hi, std::max(a, b));
+        }
+        else if (c2 < -0.5f || c2 > p[4] + 0.5f)
+            return 0;
+
+        if (lo > hi)
+            return 0;
+        spans[0] = lo;
+        spans[1] = hi;
+        return 1;
+    }
+    case PRIM_CIRCLE:
+    case PRIM_RING:
+    {
+        float dy = py - p[1];
+        float outer = (type == PRIM_CIRCLE ? p[2] : p[3]) + 0.5f;
+        if (std::fabs(dy) >= outer)
+            return 0;
+
+        float h = std::sqrt(outer * outer - dy * dy);
+        float inner = p[2] - 0.5f;
+        if (type == PRIM_CIRCLE || inner <= 0.0f || std::fabs(dy) >= inner)
+        {
+            spans[0] = p[0] - h;
+            spans[1] = p[0] + h;
+            return 1;
+        }
+
+        float hole = std::sqrt(inner * inner - dy * dy);
+        spans[0] = p[0] - h;
+        spans[1] = p[0] - hole;
+        spans[2] = p[0] + hole;
+        spans[3] = p[0] + h;
+        return 2;
+    }
+    }
+
+    spans[0] = -INFINITY;
+    spans[1] = INFINITY;
+    return 1;
+}
+
+// Shallow lines only cross a few rows of each tile they touch: limit the
+// rows to where the line passes through the columns [x_begin, x_end)
+static void
+clip_line_rows(const float *p, int x_begin, int x_end, int &y_begin, int &y_end)
+{
+    if (p[2] == 0.0f)
+        return;
+
+    const float pad = p[5] + 1.5f;
+    float t0 = (x_begin - pad - p[0]) * p[6];
+    float t1 = (x_end + pad - p[0]) * p[6];
+    if (t0 > t1)
+        std::swap(t0, t1);
+    t0 = std::max(t0, 0.0f);
+    t1 = std::min(t1, p[4]);
+    if (t0 > t1)
+    {
+        y_end = y_begin;
+        return;
+    }
+
+    float ya = p[1] + t0 * p[3];
+    float yb = p[1] + t1 * p[3];
+    y_begin = std::max(y_begin, (int) std::floor(std::min(ya, yb) - pad));
+    y_end = std::min(y_end, (int) std::ceil(std::max(ya, yb) + pad) + 1);
+}
+
+// Source-over with the alpha channel composited as if the source were
+// opaque; x/255 is rounded exactly for x <= 65535
+static inline int
+mix(int src, int dst, int a)
+{
+    int x = src * a + dst * (255 - a) + 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+static inline void
+blend(Color &dst, Color src, float coverage)
+{
+    int a = (int) std::lrint(coverage * src.a);
+    if (a <= 0)
+        return;
+
+    dst.r = (unsigned char) mix(src.r, dst.r, a);
+    dst.g = (unsigned char) mix(src.g, dst.g, a);
+    dst.b = (unsigned char) mix(src.b, dst.b, a);
+    dst.a = (unsigned char) mix(255, dst.a, a);
+}
+
+// Blends the first lanes (1..4) pixels, never touching the others since
+// they may belong to a tile rasterized by another thread
+static inline void
+blend4(Color *dst, Color src, F4 coverage, int lanes)
+{
+#ifdef SOFTRASTER_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    __m128i a = _mm_cvtps_epi32(_mm_mul_ps(coverage.v, _mm_set1_ps((float) src.a)));
+    int live = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(a, zero)));
+    if ((live & ((1 << lanes) - 1)) == 0)
+        return;
+
+    Color pixels[4];
+    if (lanes < 4)
+        std::memcpy(pixels, dst, lanes * sizeof(Color));
+    __m128i d = _mm_loadu_si128((const __m128i *) (lanes < 4 ? pixels : dst));
+
+    // Per channel 16 bit alpha: a0 a0 a0 a0 a1 a1 a1 a1 | a2 ... a3
+    __m128i a16 = _mm_packs_epi32(a, a);
+    a16 = _mm_unpacklo_epi16(a16, a16);
+    __m128i a01 = _mm_unpacklo_epi32(a16, a16);
+    __m128i a23 = _mm_unpackhi_epi32(a16, a16);
+
+    src.a = 255;
+    int packed;
+    std::memcpy(&packed, &src, sizeof(packed));
+    __m128i s16 = _mm_unpacklo_epi8(_mm_set1_epi32(packed), zero);
+
+    const __m128i k255 = _mm_set1_epi16(255);
+    const __m128i k128 = _mm_set1_epi16(128);
+    auto mix8 = [&](__m128i d16, __m128i a16) {
+        __m128i x = _mm_add_epi16(_mm_mullo_epi16(s16, a16),
+                                  _mm_mullo_epi16(d16, _mm_sub_epi16(k255, a16)));
+        x = _mm_add_epi16(x, k128);
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    };
+
+    __m128i out = _mm_packus_epi16(mix8(_mm_unpacklo_epi8(d, zero), a01),
+                                   mix8(_mm_unpackhi_epi8(d, zero), a23));
+    if (lanes == 4)
+    {
+        _mm_storeu_si128((__m128i *) dst, out);
+        return;
+    }
+    _mm_storeu_si128((__m128i *) pixels, out);
+    std::memcpy(dst, pixels, lanes * sizeof(Color));
+#else
+    float cover[4];
+    store(cover, coverage);
+    for (int i = 0; i < lanes; ++i)
+        blend(dst[i], src, cover[i]);
+#endif
+}
+
+/* Canvas font */
+
+static void
+extract_coverage(CanvasFont &font, Image atlas)
+{
+    ImageFormat(&atlas, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+    font.atlas_width = atlas.width;
+    font.atlas_height = atlas.height;
+    font.coverage.resize((size_t) atlas.width * atlas.height);
+
+    const Color *texels = (const Color *) atlas.data;
+    for (size_t i = 0; i < font.coverage.size(); ++i)
+        font.coverage[i] = texels[i].a;
+
+    UnloadImage(atlas);
+}
+
+CanvasFont::CanvasFont(const char *fileName, int fontSize) :
+    base_size(0), glyph_padding(0), atlas_width(0), atlas_height(0)
+{
+    const int glyph_count = 95;
+    const int padding = 4;
+
+    unsigned int size = 0;
+    unsigned char *data = LoadFileData(fileName, &size);
+    GlyphInfo *glyph_data = data != nullptr
+        ? LoadFontData(data, (int) size, fontSize, nullptr, glyph_count, FONT_DEFAULT)
+        : nullptr;
+    UnloadFileData(data);
+
+    if (glyph_data == nullptr)
+    {
+        TraceLog(LOG_WARNING, "SOFTRASTER: [%s] Failed to load font", fileName);
+        index_glyphs();
+        return;
+    }
+
+    Rectangle *rec_data = nullptr;
+    Image atlas = GenImageFontAtlas(glyph_data, &rec_data, glyph_count, fontSize, padding, 0);
+
+    this->base_size = fontSize;
+    this->glyph_padding = padding;
+    this->glyphs.assign(glyph_data, glyph_data + glyph_count);
+    this->recs.assign(rec_data, rec_data + glyph_count);
+    for (GlyphInfo &glyph : this->glyphs)
+        glyph.image = Image {};
+
+    UnloadFontData(glyph_data, glyph_count);
+    RL_FREE(rec_data);
+
+    extract_coverage(*this, atlas);
+    index_glyphs();
+}
+
+CanvasFont::CanvasFont(Font font) :
+    base_size(font.baseSize), glyph_padding(font.glyphPadding),
+    atlas_width(0), atlas_height(0),
+    glyphs(font.glyphs, font.glyphs + font.glyphCount),
+    recs(font.recs, font.recs + font.glyphCount)
+{
+    for (GlyphInfo &glyph : this->glyphs)
+        glyph.image = Image {};
+
+    extract_coverage(*this, LoadImageFromTexture(font.texture));
+    index_glyphs();
+}
+
+void
+CanvasFont::index_glyphs()
+{
+    std::fill(std::begin(this->ascii), std::end(this->ascii), -1);
+    for (int i = 0; i < (int) this->glyphs.size(); ++i)
+    {
+        int value = this->glyphs[i].value;
+        if (value >= 0 && value < 128 && this->ascii[value] < 0)
+            this->ascii[value] = i;
+    }
+}
+
+int
+CanvasFont::glyph_index(int codepoint) const
+{
+    if (codepoint >= 0 && codepoint < 128 && this->ascii[codepoint] >= 0)
+        return this->ascii[codepoint];
+
+    for (int i = 0; i < (int) this->glyphs.size(); ++i)
+        if (this->glyphs[i].value == codepoint)
+            return i;
+
+    // Same fallback as GetGlyphIndex()
+    return this->ascii['?'] >= 0 ? this->ascii['?'] : 0;
+}
+
+Vector2
+CanvasFont::measure(const char *text, float font_size, float spacing) const
+{
+    if (this->base_size <= 0 || this->glyphs.empty())
+        return Vector2 { 0, 0 };
+
+    const float scale = font_size / this->base_size;
+    float line_width = 0.0f, width = 0.0f;
+    int line_glyphs = 0, glyphs = 0;
+    int lines = 1;
+
+    for (int i = 0; text[i] != '\0';)
+    {
+        int bytes = 0;
+        int codepoint = GetCodepoint(&text[i], &bytes);
+        if (codepoint == 0x3f)
+            bytes = 1;
+        i += bytes;
+
+        if (codepoint == '\n')
+        {
+            line_width = 0.0f;
+            line_glyphs = 0;
+            ++lines;
+            continue;
+        }
+
+        int index = glyph_index(codepoint);
+        line_width += this->glyphs[index].advanceX == 0
+            ? this->recs[index].width + this->glyphs[index].offsetX
+            : this->glyphs[index].advanceX;
+        ++line_glyphs;
+
+        width = std::max(width, line_width);
+        glyphs = std::max(glyphs, line_glyphs);
+    }
+
+    return Vector2 {
+        width * scale + std::max(0, glyphs - 1) * spacing,
+        (this->base_size + (lines - 1) * this->base_size * 1.5f) * scale
+    };
+}
+
+/* Canvas */
+
+Canvas::Canvas(int width, int height, int threads) :
+    width(width), height(height),
+    pixels((size_t) width * height, Color { 0, 0, 0, 0 }),
+    tiles_x((width + TILE_SIZE - 1) / TILE_SIZE),
+    tiles_y((height + TILE_SIZE - 1) / TILE_SIZE),
+    bins(tiles_x * tiles_y),
+    cleared(false),
+    clear_color { 0, 0, 0, 0 },
+    next_tile(0),
+    generation(0),
+    busy(0),
+    stopping(false)
+{
+    if (threads <= 0)
+        threads = std::max(1, (int) std::thread::hardware_concurrency());
+
+    // The calling thread rasterizes too
+    for (int i = 1; i < threads; ++i)
+        this->workers.emplace_back(&Canvas::worker_loop, this);
+}
+
+Canvas::~Canvas()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->work_cv.notify_all();
+
+    for (std::thread &worker : this->workers)
+        worker.join();
+}
+
+int
+Canvas::thread_count() const
+{
+    return (int) this->workers.size() + 1;
+}
+
+void
+Canvas::clear(Color color)
+{
+    // Everything recorded so far would be overwritten
+    this->primitives.clear();
+    for (std::vector<uint32_t> &bin : this->bins)
+        bin.clear();
+
+    this->cleared = true;
+    this->clear_color = color;
+}
+
+bool
+Canvas::touches(const Primitive &primitive, int tile_x, int tile_y) const
+{
+    // Tile bounds in pixel center coordinates
+    const float x0 = tile_x * TILE_SIZE + 0.5f;
+    const float y0 = tile_y * TILE_SIZE + 0.5f;
+    const float x1 = x0 + TILE_SIZE - 1;
+    const float y1 = y0 + TILE_SIZE - 1;
+    const float *p = primitive.p;
+
+    switch (primitive.type)
+    {
+    case PRIM_LINE:
+    case PRIM_LINE_AA:
+    {
+        // Separating axis test against the line's own axes
+        float r = p[5] + 0.5f;
+        float perp[4], along[4];
+        const float cx[4] = { x0, x1, x0, x1 };
+        const float cy[4] = { y0, y0, y1, y1 };
+        for (int i = 0; i < 4; ++i)
+        {
+            perp[i] = (cy[i] - p[1]) * p[2] - (cx[i] - p[0]) * p[3];
+            along[i] = (cx[i] - p[0]) * p[2] + (cy[i] - p[1]) * p[3];
+        }
+
+        auto [perp_min, perp_max] = std::minmax_element(perp, perp + 4);
+        auto [along_min, along_max] = std::minmax_element(along, along + 4);
+        return *perp_min <= r && *perp_max >= -r
+            && *along_min <= p[4] + 0.5f && *along_max >= -0.5f;
+    }
+    case PRIM_CIRCLE:
+    case PRIM_RING:
+    {
+        float outer = (primitive.type == PRIM_CIRCLE ? p[2] : p[3]) + 0.5f;
+        float nx = std::min(std::max(p[0], x0), x1) - p[0];
+        float ny = std::min(std::max(p[1], y0), y1) - p[1];
+        if (nx * nx + ny * ny > outer * outer)
+            return false;
+
+        if (primitive.type == PRIM_CIRCLE)
+            return true;
+
+        // Tiles inside the hole
+        float fx = std::max(std::fabs(x0 - p[0]), std::fabs(x1 - p[0]));
+        float fy = std::max(std::fabs(y0 - p[1]), std::fabs(y1 - p[1]));
+        float inner = p[2] - 0.5f;
+        return inner <= 0.0f || fx * fx + fy * fy >= inner * inner;
+    }
+    }
+
+    return true;
+}
+
+void
+Canvas::submit(Primitive &primitive, float x0, float y0, float x1, float y1)
+{
+    primitive.x0 = std::max(0, (int) std::floor(x0));
+    primitive.y0 = std::max(0, (int) std::floor(y0));
+    primitive.x1 = std::min(this->width, (int) std::ceil(x1) + 1);
+    primitive.y1 = std::min(this->height, (int) std::ceil(y1) + 1);
+    if (primitive.x0 >= primitive.x1 || primitive.y0 >= primitive.y1)
+        return;
+
+    const uint32_t index = (uint32_t) this->primitives.size();
+    this->primitives.push_back(primitive);
+
+    const int tx1 = (primitive.x1 - 1) / TILE_SIZE;
+    const int ty1 = (primitive.y1 - 1) / TILE_SIZE;
+    for (int ty = primitive.y0 / TILE_SIZE; ty <= ty1; ++ty)
+        for (int tx = primitive.x0 / TILE_SIZE; tx <= tx1; ++tx)
+            if (touches(primitive, tx, ty))
+                this->bins[ty * this->tiles_x + tx].push_back(index);
+}
+
+static bool
+make_line(float *p, Vector2 start, Vector2 end, float half_width)
+{
+    Vector2 d = end - start;
+    float length = std::sqrt(d.x * d.x + d.y * d.y);
+    if (length < 1e-6f)
+        return false;
+
+    p[0] = start.x;
+    p[1] = start.y;
+    p[2] = d.x / length;
+    p[3] = d.y / length;
+    p[4] = length;
+    p[5] = half_width < 0.0f
+        ? 0.5f * std::max(std::fabs(p[2]), std::fabs(p[3]))
+        : half_width;
+    p[6] = p[2] != 0.0f ? 1.0f / p[2] : 0.0f;
+    p[7] = p[3] != 0.0f ? 1.0f / p[3] : 0.0f;
+    return true;
+}
+
+void
+Canvas::line(Vector2 start, Vector2 end, Color color)
+{
+    Primitive primitive = {};
+    primitive.type = PRIM_LINE;
+    primitive.color = color;
+    if (!make_line(primitive.p, start, end, -1.0f))
+        return;
+
+    submit(primitive,
+           std::min(start.x, end.x) - 1, std::min(start.y, end.y) - 1,
+           std::max(start.x, end.x) + 1, std::max(start.y, end.y) + 1);
+}
+
+void
+Canvas::line(Vector2 start, Vector2 end, float thick, Color color)
+{
+    Primitive primitive = {};
+    primitive.type = PRIM_LINE_AA;
+    primitive.color = color;
+    if (!make_line(primitive.p, start, end, thick * 0.5f))
+        return;
+
+    float pad = thick * 0.5f + 1;
+    submit(primitive,
+           std::min(start.x, end.x) - pad, std::min(start.y, end.y) - pad,
+           std::max(start.x, end.x) + pad, std::max(start.y, end.y) + pad);
+}
+
+void
+Canvas::circle(Vector2 center, float radius, Color color)
+{
+    Primitive primitive = {};
+    primitive.type = PRIM_CIRCLE;
+    primitive.color = color;
+    primitive.p[0] = center.x;
+    primitive.p[1] = center.y;
+    primitive.p[2] = radius;
+
+    float pad = radius + 1;
+    submit(primitive, center.x - pad, center.y - pad, center.x + pad, center.y + pad);
+}
+
+void
+Canvas::ring(Vector2 center, float inner_radius, float outer_radius, Color color)
+{
+    if (inner_radius > outer_radius)
+        std::swap(inner_radius, outer_radius);
+
+    Primitive primitive = {};
+    primitive.type = PRIM_RING;
+    primitive.color = color;
+    primitive.p[0] = center.x;
+    primitive.p[1] = center.y;
+    primitive.p[2] = inner_radius;
+    primitive.p[3] = outer_radius;
+
+    float pad = outer_radius + 1;
+    submit(primitive, center.x - pad, center.y - pad, center.x + pad, center.y + pad);
+}
+
+void
+Canvas::rectangle(Rectangle rec, Color color)
+{
+    Primitive primitive = {};
+    primitive.type = PRIM_RECT;
+    primitive.color = color;
+    primitive.p[0] = rec.x;
+    primitive.p[1] = rec.y;
+    primitive.p[2] = rec.x + rec.width;
+    primitive.p[3] = rec.y + rec.height;
+
+    submit(primitive, rec.x - 1, rec.y - 1, rec.x + rec.width + 1, rec.y + rec.height + 1);
+}
+
+void
+Canvas::text(const CanvasFont &font, const char *text, Vector2 position,
+             float font_size, float spacing, Color color)
+{
+    if (font.base_size <= 0 || font.glyphs.empty())
+        return;
+
+    const float scale = font_size / font.base_size;
+    const float padding = (float) font.glyph_padding;
+    float offset_x = 0.0f;
+    int offset_y = 0;
+
+    for (int i = 0; text[i] != '\0';)
+    {
+        int bytes = 0;
+        int codepoint = GetCodepoint(&text[i], &bytes);
+        if (codepoint == 0x3f)
+            bytes = 1;
+        i += bytes;
+
+        int index = font.glyph_index(codepoint);
+        const GlyphInfo &glyph = font.glyphs[index];
+        const Rectangle &rec = font.recs[index];
+
+        if (codepoint == '\n')
+        {
+            offset_y += (int) ((font.base_size + font.base_size / 2) * scale);
+            offset_x = 0.0f;
+            continue;
+        }
+
+        if (codepoint != ' ' && codepoint != '\t')
+        {
+            Rectangle dst = {
+                position.x + offset_x + (glyph.offsetX - padding) * scale,
+                position.y + offset_y + (glyph.offsetY - padding) * scale,
+                (rec.width + 2 * padding) * scale,
+                (rec.height + 2 * padding) * scale,
+            };
+
+            Primitive primitive = {};
+            primitive.type = PRIM_GLYPH;
+            primitive.color = color;
+            primitive.font = &font;
+            primitive.p[0] = dst.x;
+            primitive.p[1] = dst.y;
+            primitive.p[2] = rec.x - padding;
+            primitive.p[3] = rec.y - padding;
+            primitive.p[4] = rec.width + 2 * padding;
+            primitive.p[5] = rec.height + 2 * padding;
+            primitive.p[6] = primitive.p[4] / dst.width;
+            primitive.p[7] = primitive.p[5] / dst.height;
+
+            // Pixels whose center lies inside the destination rectangle
+            submit(primitive,
+                   std::ceil(dst.x - 0.5f), std::ceil(dst.y - 0.5f),
+                   std::ceil(dst.x + dst.width - 0.5f) - 1,
+                   std::ceil(dst.y + dst.height - 0.5f) - 1);
+        }
+
+        offset_x += glyph.advanceX == 0
+            ? rec.width * scale + spacing
+            : glyph.advanceX * scale + spacing;
+    }
+}
+
+void
+Canvas::rasterize_tile(int tile)
+{
+    const std::vector<uint32_t> &bin = this->bins[tile];
+    if (bin.empty() && !this->cleared)
+        return;
+
+    const int tile_x0 = (tile % this->tiles_x) * TILE_SIZE;
+    const int tile_y0 = (tile / this->tiles_x) * TILE_SIZE;
+    const int tile_x1 = std::min(tile_x0 + TILE_SIZE, this->width);
+    const int tile_y1 = std::min(tile_y0 + TILE_SIZE, this->height);
+
+    if (this->cleared)
+        for (int y = tile_y0; y < tile_y1; ++y)
+            std::fill_n(&this->pixels[(size_t) y * this->width + tile_x0],
+                        tile_x1 - tile_x0, this->clear_color);
+
+    for (uint32_t index : bin)
+    {
+        const Primitive &primitive = this->primitives[index];
+        const float *p = primitive.p;
+        const int x_begin = std::max(tile_x0, primitive.x0);
+        const int x_end = std::min(tile_x1, primitive.x1);
+        int y_begin = std::max(tile_y0, primitive.y0);
+        int y_end = std::min(tile_y1, primitive.y1);
+
+        if (primitive.type == PRIM_LINE || primitive.type == PRIM_LINE_AA)
+            clip_line_rows(p, x_begin, x_end, y_begin, y_end);
+
+        for (int y = y_begin; y < y_end; ++y)
+        {
+            Color *row = &this->pixels[(size_t) y * this->width];
+            const float py = y + 0.5f;
+
+            if (primitive.type == PRIM_GLYPH)
+            {
+                const CanvasFont &font = *primitive.font;
+                int v = (int) std::floor(p[3] + (py - p[1]) * p[7]);
+                v = std::min(std::max(v, (int) p[3]), (int) (p[3] + p[5]) - 1);
+                if (v < 0 || v >= font.atlas_height)
+                    continue;
+
+                const unsigned char *texels = &font.coverage[(size_t) v * font.atlas_width];
+                for (int x = x_begin; x < x_end; ++x)
+                {
+                    int u = (int) std::floor(p[2] + (x + 0.5f - p[0]) * p[6]);
+                    u = std::min(std::max(u, (int) p[2]), (int) (p[2] + p[4]) - 1);
+                    if (u >= 0 && u < font.atlas_width)
+                        blend(row[x], primitive.color, texels[u] / 255.0f);
+                }
+                continue;
+            }
+
+            float spans[4];
+            const int span_count = row_spans(p, primitive.type, py, spans);
+            for (int s = 0; s < span_count; ++s)
+            {
+                // Pixels whose center is in [lo, hi], with a little slack
+                // for rounding; both are clamped to the tile so truncation
+                // rounds down
+                float lo = std::max(spans[s * 2] - 0.5f - 1.0f / 64, (float) x_begin);
+                float hi = std::min(spans[s * 2 + 1] + 0.5f + 1.0f / 64, (float) x_end);
+                const int xs = (int) lo;
+                const int xe = (int) hi;
+
+                for (int x = xs; x < xe; x += 4)
+                {
+                    blend4(&row[x], primitive.color,
+                           coverage(p, primitive.type, (float) x, py),
+                           std::min(4, xe - x));
+                }
+            }
+        }
+    }
+}
+
+void
+Canvas::rasterize_tiles()
+{
+    const int tile_count = this->tiles_x * this->tiles_y;
+    for (int tile; (tile = this->next_tile.fetch_add(1)) < tile_count;)
+        rasterize_tile(tile);
+}
+
+void
+Canvas::worker_loop()
+{
+    PROFILE_THREAD("softraster worker");
+
+    uint64_t seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->work_cv.wait(lock, [&] {
+                return this->stopping || this->generation != seen;
+            });
+            if (this->stopping)
+                return;
+            seen = this->generation;
+        }
+
+        {
+            PROFILE_SCOPE("Canvas tiles");
+            rasterize_tiles();
+        }
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (--this->busy == 0)
+            this->done_cv.notify_one();
+    }
+}
+
+void
+Canvas::flush()
+{
+    if (this->primitives.empty() && !this->cleared)
+        return;
+
+    PROFILE_SCOPE("Canvas::flush");
+
+    if (this->workers.empty())
+    {
+        this->next_tile = 0;
+        rasterize_tiles();
+    }
+    else
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->next_tile = 0;
+            this->busy = (int) this->workers.size();
+            ++this->generation;
+        }
+        this->work_cv.notify_all();
+
+        rasterize_tiles();
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->done_cv.wait(lock, [&] { return this->busy == 0; });
+    }
+
+    this->primitives.clear();
+    for (std::vector<uint32_t> &bin : this->bins)
+        bin.clear();
+    this->cleared = false;
+}
+
+Image
+Canvas::to_image()
+{
+    flush();
+
+    const size_t size = this->pixels.size() * sizeof(Color);
+    Image image = {
+        RL_MALLOC(size), this->width, this->height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8
+    };
+    std::memcpy(image.data, this->pixels.data(), size);
+    return image;
+}
@@ -1,16 +1,28 @@
 #include <raylib-ext.hpp>
+#include <raylib-ext/profiler.hpp>
 #include <okna.hpp>
+#include <harness.hpp>
+#include <jobs.hpp>
+#include <jobs/frame-graph.hpp>
+#include <softraster.hpp>
 
 #include <algorithm>
+#include <cstdio>
 #include <vector>
 
 const int BALL_W = 60;
 const int BALL_H = 60;
-Vector2 ball_speed = { 450, -450 };
+const Vector2 BALL_SPEED = { 450, -450 };
 
 const int BAR_W = 200;
 const int BAR_H = 60;
 
+struct Ball
+{
+    Rectangle rect;
+    Vector2 speed;
+};
+
 enum Collision {
     COLLISION_LEFT,
     COLLISION_RIGHT,
@@ -19,29 +31,34 @@ enum Collision {
     COLLISION_NONE,
 };
 
-Collision collide(const Window &a, const Window &b)
+Rectangle window_rect(const Window &window)
+{
+    return { window.pos.x, window.pos.y, float(window.width), float(window.height) };
+}
+
+Collision collide(Rectangle a, Rectangle b)
 {
-    if (!(a.pos.x + a.width < b.pos.x || a.pos.x > b.pos.x + b.width ||
-          a.pos.y + a.height < b.pos.y || a.pos.y > b.pos.y + b.height))
+    if (!(a.x + a.width < b.x || a.x > b.x + b.width ||
+          a.y + a.height < b.y || a.y > b.y + b.height))
     {
-        float dx1 = abs(a.pos.x + a.width - b.pos.x);
-        float dx2 = abs(b.pos.x + b.width - a.pos.x);
+        float dx1 = abs(a.x + a.width - b.x);
+        float dx2 = abs(b.x + b.width - a.x);
         float dx = std::min({ dx1, dx2, dx1 + dx2 - std::max(a.width, b.width) });
 
-        float dy1 = abs(a.pos.y + a.height - b.pos.y);
-        float dy2 = abs(b.pos.y + b.height - a.pos.y);
+        float dy1 = abs(a.y + a.height - b.y);
+        float dy2 = abs(b.y + b.height - a.y);
         float dy = std::min({ dy1, dy2, dy1 + dy2 - std::max(a.height, b.height) });
 
         if (dx > dy)
         {
-            float dist_t = a.pos.y + a.height - b.pos.y;
-            float dist_b = b.pos.y + b.height - a.pos.y;
+            float dist_t = a.y + a.height - b.y;
+            float dist_b = b.y + b.height - a.y;
             return (dist_t <= dist_b) ? COLLISION_TOP : COLLISION_BOTTOM;
         }
         else
         {
-            float dist_l = a.pos.x + a.width - b.pos.x;
-            float dist_r = b.pos.x + b.width - a.pos.x;
+            float dist_l = a.x + a.width - b.x;
+            float dist_r = b.x + b.width - a.x;
             return (dist_l <= dist_r) ? COLLISION_LEFT : COLLISION_RIGHT;
         }
     }
@@ -49,25 +66,25 @@ Collision collide(const Window &a, const Window &b)
     return COLLISION_NONE;
 }
 
-bool reflect(Window &ball, Window &obj, Vector2 &ball_speed)
+bool reflect(Rectangle &ball, Rectangle obj, Vector2 &ball_speed)
 {
     switch (collide(ball, obj))
     {
     case COLLISION_LEFT:
         ball_speed.x = -abs(ball_speed.x);
-        ball.set_position(Vector2{ obj.pos.x - ball.width, ball.pos.y });
+        ball.x = obj.x - ball.width;
         break;
     case COLLISION_RIGHT:
         ball_speed.x = abs(ball_speed.x);
-        ball.set_position(Vector2{ obj.pos.x + obj.width, ball.pos.y });
+        ball.x = obj.x + obj.width;
         break;
     case COLLISION_TOP:
         ball_speed.y = -abs(ball_speed.y);
-        ball.set_position(Vector2{ ball.pos.x, obj.pos.y - ball.height });
+        ball.y = obj.y - ball.height;
         break;
     case COLLISION_BOTTOM:
         ball_speed.y = abs(ball_speed.y);
-        ball.set_position(Vector2{ ball.pos.x, obj.pos.y + obj.height });
+        ball.y = obj.y + obj.height;
         break;
     case COLLISION_NONE:
         return false;
@@ -76,8 +93,63 @@ bool reflect(Window &ball, Window &obj, Vector2 &ball_speed)
     return true;
 }
 
-int main()
+// Touches no window, so it can run on any thread
+void simulate(const Ball &previous, Ball &ball, Rectangle bar, Vector2 monitor_dim, float dt)
 {
+    ball = previous;
+    ball.rect.x += ball.speed.x * dt;
+    ball.rect.y += ball.speed.y * dt;
+    if (ball.rect.x < 0 || ball.rect.x + ball.rect.width >= monitor_dim.x)
+        ball.speed.x *= -1;
+    if (ball.rect.y < 0 || ball.rect.y + ball.rect.height >= monitor_dim.y)
+        ball.speed.y *= -1;
+    reflect(ball.rect, bar, ball.speed);
+}
+
+// The ball bouncing off a bar that stays put on a 1920x1080 monitor, drawn
+// at half size. Needs no window, for the harness.
+HarnessSketch headless_sketch()
+{
+    const Vector2 monitor_dim = { 1920, 1080 };
+    const float scale = 0.5f;
+
+    Rectangle bar = {
+        (monitor_dim.x - BAR_W) / 2, monitor_dim.y - BAR_H - 100, BAR_W, BAR_H
+    };
+    Ball ball = {
+        Rectangle { (monitor_dim.x - BALL_W) / 2, bar.y - BALL_H, BALL_W, BALL_H },
+        BALL_SPEED
+    };
+
+    auto scaled = [scale](Rectangle rect) {
+        return Rectangle { rect.x * scale, rect.y * scale, rect.width * scale, rect.height * scale };
+    };
+
+    return HarnessSketch {
+        "breakout", int(monitor_dim.x * scale), int(monitor_dim.y * scale),
+        [=](int frame, Canvas &canvas) mutable {
+            if (frame > 0)
+            {
+                Ball previous = ball;
+                simulate(previous, ball, bar, monitor_dim, 1.0f / 60.0f);
+            }
+            canvas.clear(BLACK);
+            canvas.rectangle(scaled(bar), VIOLET);
+            canvas.rectangle(scaled(ball.rect), MAROON);
+        }
+    };
+}
+
+// Usage: breakout [--bench <frames> [--warmup <n>] [--seed <n>]]
+//        breakout --harness <directory> [--update]
+int main(int argc, char **argv)
+{
+    PROFILE_THREAD("main");
+
+    // Golden image and frame time checks, see Projects/CMakeLists.txt
+    if (harness_requested(argc, argv))
+        return harness_main(argc, argv, headless_sketch());
+
     okna_init();
 
     Vector2 monitor_dim = okna_get_monitor_size();
@@ -93,23 +165,96 @@ int main()
     }, false);
     ball.fill(MAROON);
 
+    // A frame reads the windows, simulates the ball on the pool and moves
+    // the ball window. Presenting runs a frame late from its own buffer of
+    // the ball, so the next frame simulates while the last one is presented.
+    JobPool jobs;
+    FrameGraph graph(jobs);
+    FrameResource input_state = graph.add_resource("input");
+    FrameResource ball_state = graph.add_resource("ball", 2);
+
+    Rectangle bar_rect = window_rect(bar);
+    Ball start = { window_rect(ball), BALL_SPEED };
+    Ball balls[2] = { start, start };
+    float frame_dt = 1.0f / 60.0f;
+
+    // Where present last put the ball window, as the OS reports it. The
+    // window being elsewhere in the next frame means it was dragged, and
+    // the ball carries on from there.
+    Vector2 presented = ball.pos;
+    bool dragged = false;
+    Vector2 dragged_to = ball.pos;
+
+    graph.add_task("input", { frame_writes(input_state) }, [&](uint64_t) {
+        bar.sync();
+        bar_rect = window_rect(bar);
+
+        ball.sync_position();
+        dragged = ball.pos.x != presented.x || ball.pos.y != presented.y;
+        if (dragged)
+        {
+            dragged_to = ball.pos;
+            presented = ball.pos;
+        }
+    }, FRAME_TASK_MAIN_THREAD);
+
+    graph.add_task("simulate", {
+        frame_reads(input_state), frame_reads_previous(ball_state), frame_writes(ball_state)
+    }, [&](uint64_t frame) {
+        Ball previous = balls[graph.buffer(ball_state, frame - 1)];
+        if (dragged)
+        {
+            previous.rect.x = dragged_to.x;
+            previous.rect.y = dragged_to.y;
+        }
+        simulate(previous, balls[graph.buffer(ball_state, frame)],
+                 bar_rect, monitor_dim, frame_dt);
+    });
+
+    graph.add_task("present", { frame_reads(ball_state) }, [&](uint64_t frame) {
+        const Ball &state = balls[graph.buffer(ball_state, frame)];
+        ball.set_position(Vector2 { state.rect.x, state.rect.y });
+        ball.sync();
+        presented = ball.pos;
+    }, FRAME_TASK_MAIN_THREAD | FRAME_TASK_DEFERRED);
+
+    graph.compile();
+
+    // Benchmarks step on a virtual clock instead of waiting in Clock::tick()
+    if (bench_requested(argc, argv))
+    {
+        double wall_ms = 0.0;
+        double critical_ms = 0.0;
+        int frames = 0;
+        int result = bench_main(argc, argv, "breakout", [&](int frame, float dt) {
+            frame_dt = dt;
+            graph.run(frame);
+            wall_ms += graph.timing().wall_ms;
+            critical_ms += graph.timing().critical_ms;
+            ++frames;
+        });
+        std::printf("breakout: graph %.3f ms/frame, critical path %.3f ms/frame\n",
+                    wall_ms / frames, critical_ms / frames);
+        okna_terminate();
+        return result;
+    }
+
     Clock clock = Clock(60);
     clock.start();
+    uint64_t frame = 0;
     while (bar.active)
     {
-        ball.move(ball_speed * clock.dt);
-        if (ball.pos.x < 0 || ball.pos.x + ball.width >= monitor_dim.x)
-            ball_speed.x *= -1;
-        if (ball.pos.y < 0 || ball.pos.y + ball.height >= monitor_dim.y)
-            ball_speed.y *= -1;
-        reflect(ball, bar, ball_speed);
-
-        bar.sync();
-        ball.sync();
+        frame_dt = clock.dt;
+        graph.run(frame++);
         clock.tick();
     }
 
     okna_terminate();
+
+    // Built with -DRAYLIB_EXT_PROFILER=ON, open in chrome://tracing
+#ifdef RAYLIB_EXT_PROFILER
+    ExportProfile("breakout-profile.json");
+#endif
+
     return 0;
 }
-
@@ -1,27 +1,78 @@
 #include <raylib-ext.hpp>
+#include <raylib-ext/alloc-stats.hpp>
+#include <harness.hpp>
+#include <softraster.hpp>
+#include <cstring>
 
-int main()
+// Usage: example-project [--alloc-traces] [--bench <frames> [--warmup <n>] [--seed <n>]]
+//        example-project --harness <directory> [--update]
+int main(int argc, char **argv)
 {
     const int screen_width = 640;
     const int screen_height = 480;
+    const int font_size = 30;
+
+    // Built outside the loop: a std::string this long is a heap allocation
+    const std::string msg = "Welcome, Creative Coders!";
+
+    // Golden image and frame time checks, see Projects/CMakeLists.txt.
+    // raylib's default font needs a GL context, so the CPU rasterizer draws
+    // the message with a TTF instead.
+    if (harness_requested(argc, argv))
+    {
+        CanvasFont font(RESOURCES_DIR "Lato-Regular.ttf", font_size);
+        return harness_main(argc, argv, HarnessSketch {
+            "example-project", screen_width, screen_height,
+            [&](int, Canvas &canvas) {
+                Vector2 size = font.measure(msg.c_str(), font_size, 0);
+                canvas.clear(BLACK);
+                canvas.text(font, msg.c_str(), Vector2 {
+                    (screen_width - size.x) / 2, (screen_height - size.y) / 2
+                }, font_size, 0, WHITE);
+            }
+        });
+    }
+
+    // Benchmarks draw as fast as possible in a hidden window
+    const bool bench = bench_requested(argc, argv);
+    if (bench)
+    {
+        SetTraceLogLevel(LOG_WARNING);
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    }
 
     InitWindow(screen_width, screen_height, "Creative Coding: Welcome!");
-    SetTargetFPS(60);
+    if (!bench)
+        SetTargetFPS(60);
+
+    // With -DRAYLIB_EXT_ALLOC_STATS=ON, anything that allocates while drawing
+    // is reported; --alloc-traces prints the stack of each call site too,
+    // which is slow and noisy, so it is left off otherwise
+    for (int i = 1; i < argc; ++i)
+        if (std::strcmp(argv[i], "--alloc-traces") == 0)
+            SetNoAllocStackTraces(true);
 
-    while (!WindowShouldClose())
+    auto draw = [&]()
     {
+        BeginNoAlloc("draw");
         BeginDrawing();
         {
             ClearBackground(BLACK);
-            int font_size = 30;
-            std::string msg = "Welcome, Creative Coders!";
             int x = (screen_width - MeasureText(msg, font_size)) / 2;
             int y = (screen_height - font_size) / 2;
             DrawText(msg, x, y, font_size, WHITE);
         }
         EndDrawing();
-    }
+        EndNoAlloc();
+    };
+
+    int result = 0;
+    if (bench)
+        result = bench_main(argc, argv, "example-project", [&](int, float) { draw(); });
+
+    while (!bench && !WindowShouldClose())
+        draw();
     CloseWindow();
 
-    return 0;
+    return result;
 }
@@ -1,63 +1,282 @@
 #define RAYEXT_IMPLEMENTATION
 #include <raylib-ext.hpp>
+#include <raylib-ext/batch-draw.hpp>
+#include <raylib-ext/capture.hpp>
+#include <raylib-ext/chords.hpp>
+#include <raylib-ext/frame-arena.hpp>
+#include <raylib-ext/profiler.hpp>
+#include <raylib-ext/record.hpp>
+#include <raylib-ext/render-stats.hpp>
+#include <harness.hpp>
+#include <jobs.hpp>
+#include <softraster.hpp>
+#include <softraster/offline.hpp>
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
 
-int main()
+const int screen_radius = 350;
+const int screen_width = screen_radius * 2;
+const int screen_height = screen_radius * 2;
+const float step = 0.01f;
+
+// Everything in a frame follows from its index
+float frame_multiple(int frame)
+{
+    return 1.0f + step * frame;
+}
+
+Color frame_color(int frame)
+{
+    return ColorFromHSV(std::fmod(0.5f * frame, 360.0f), 1, 1);
+}
+
+// Fills points [first * 2, last * 2) of the lines_count * 2; ranges can be
+// filled in parallel
+void chord_points(int frame, int lines_count, int first, int last,
+                  Vector2 center, float radius, Vector2 *points)
+{
+    PROFILE_FUNCTION();
+
+    const float theta = 2.0 * PI / lines_count;
+    const float multiple = frame_multiple(frame);
+
+    for (int n = first; n < last; ++n)
+    {
+        Vector2 start = Vector2 {
+            cosf(theta * n),
+            sinf(theta * n)
+        } * radius + center;
+
+        Vector2 end = Vector2 {
+            cosf(theta * multiple * n),
+            sinf(theta * multiple * n)
+        } * radius + center;
+
+        points[n * 2] = start;
+        points[n * 2 + 1] = end;
+    }
+}
+
+// CPU version of a frame at any canvas size; safe to call from several
+// threads at once
+void render(int frame, Canvas &canvas, int lines_count)
 {
-    const int screen_radius = 350;
-    const int screen_width = screen_radius * 2;
-    const int screen_height = screen_radius * 2;
+    PROFILE_FUNCTION();
+
+    const float radius = std::min(canvas.width, canvas.height) / 2 - 10;
+    const Vector2 center = { canvas.width / 2.0f, canvas.height / 2.0f };
+    const Color line_color = frame_color(frame);
+
+    thread_local std::vector<Vector2> points;
+    points.resize(lines_count * 2);
+    chord_points(frame, lines_count, 0, lines_count, center, radius, points.data());
+
+    canvas.clear(BLACK);
+    canvas.ring(center, radius + 1, radius + 3, line_color);
+    for (size_t i = 0; i < points.size(); i += 2)
+        canvas.line(points[i], points[i + 1], line_color);
+}
+
+int main(int argc, char **argv)
+{
+    PROFILE_THREAD("main");
+
+    // Golden image and frame time checks, see Projects/CMakeLists.txt
+    if (harness_requested(argc, argv))
+    {
+        return harness_main(argc, argv, HarnessSketch {
+            "times-table", screen_width, screen_height,
+            [](int frame, Canvas &canvas) { render(frame, canvas, 200); }
+        });
+    }
+
+    // Usage: times-table [lines] [--software]
+    //        times-table [lines] [--software] --bench <frames> [--warmup <n>] [--seed <n>]
+    //        times-table [lines] --offline <frames> [--size <pixels>] [--threads <n>] [--qoi]
+    int lines_count = 200;
+    bool software = false;
+    int offline_frames = 0;
+    int offline_size = screen_width;
+    int offline_threads = 0;
+    CaptureFormat offline_format = CAPTURE_PNG;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--software") == 0)
+            software = true;
+        else if (std::strcmp(argv[i], "--offline") == 0 && i + 1 < argc)
+            offline_frames = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--size") == 0 && i + 1 < argc)
+            offline_size = std::max(32, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            offline_threads = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--qoi") == 0)
+            offline_format = CAPTURE_QOI;
+        else if ((std::strcmp(argv[i], "--bench") == 0 || std::strcmp(argv[i], "--warmup") == 0 ||
+                  std::strcmp(argv[i], "--seed") == 0) && i + 1 < argc)
+            ++i; // read by bench_main()
+        else
+            lines_count = std::max(1, std::atoi(argv[i]));
+    }
+
+    // Renders the animation into times-table-offline/ without opening a window
+    if (offline_frames > 0)
+    {
+        SetTraceLogLevel(LOG_WARNING);
+        OfflineStats stats = render_offline(
+            [&](int frame, Canvas &canvas) { render(frame, canvas, lines_count); },
+            0, offline_frames, offline_size, offline_size,
+            "times-table-offline", offline_format, offline_threads
+        );
+        std::printf("%d frames (%dx%d, %d lines) in %.2f s on %d threads: %.1f frames/s\n",
+                    stats.frames, offline_size, offline_size, lines_count,
+                    stats.seconds, stats.threads, stats.frames_per_second);
+#ifdef RAYLIB_EXT_PROFILER
+        ExportProfile("times-table-profile.json");
+#endif
+        return stats.failed == 0 ? 0 : 1;
+    }
+
+    // Benchmarks draw the same frames as fast as possible in a hidden window
+    const bool bench = bench_requested(argc, argv);
+    if (bench)
+    {
+        SetTraceLogLevel(LOG_WARNING);
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    }
+
+    // Computes the chord points of big frames on every core
+    JobPool jobs;
 
     InitWindow(screen_width, screen_height, "Creative Coding: Times Table");
-    SetTargetFPS(60);
+    if (!bench)
+        SetTargetFPS(60);
+    EnableRenderStats();
 
-    const int lines_count = 200;
     const int radius = screen_radius - 10;
     const Vector2 center = { screen_radius, screen_radius };
-    const float step = 0.01f;
-    const float theta = 2.0 * PI / lines_count;
 
-    float multiple = 1.0f;
-    float hue = 0;
+    // The border never changes shape, only color
+    BeginRecord();
+    DrawRing(center, radius + 1, radius + 3, 0, 360, 200, WHITE);
+    RecordedGeometry border = EndRecord();
+
+    int frame = 0;
+
+    // Press R to start/stop recording frames into times-table-frames/
+    std::unique_ptr<FrameCapture> capture;
+
+    // Press F1 to show the render batch stats
+    bool show_stats = false;
+
+    // Press G to compute the lines in the vertex shader instead of the CPU
+    bool gpu_lines = lines_count > 10000;
+
+    // Press S to rasterize frames on the CPU and show them as a texture
+    std::unique_ptr<Canvas> canvas;
+    Texture2D canvas_texture = {};
 
-    while (!WindowShouldClose())
+    auto draw = [&](int frame)
     {
-        multiple += step;
+        if (software && !canvas)
+        {
+            canvas = std::make_unique<Canvas>(screen_width, screen_height);
+            Image blank = GenImageColor(screen_width, screen_height, BLANK);
+            canvas_texture = LoadTextureFromImage(blank);
+            UnloadImage(blank);
+        }
+
+        // Start the points on the pool, they are joined before DrawLines()
+        const bool cpu_lines = !software && !gpu_lines;
+        Vector2 *points = nullptr;
+        auto fill = [&](int first, int last) {
+            chord_points(frame, lines_count, first, last, center, radius, points);
+        };
+        if (cpu_lines)
+        {
+            points = GetFrameArena().allocate_array<Vector2>(lines_count * 2);
+            parallel_for(jobs.frame, 0, lines_count, 1024, fill);
+        }
 
         BeginDrawing();
         {
             ClearBackground(BLACK);
 
-            Color line_color = ColorFromHSV(hue, 1, 1);
-
-            DrawRing(
-                center, radius + 1, radius + 3,
-                0, 360, 200, line_color
-            );
+            Color line_color = frame_color(frame);
 
-            for (int n = 0; n < lines_count; ++n)
+            if (software)
             {
-                Vector2 start = Vector2 {
-                    cosf(theta * n),
-                    sinf(theta * n)
-                } * radius + center;
+                render(frame, *canvas, lines_count);
+                canvas->flush();
 
-                Vector2 end = Vector2 {
-                    cosf(theta * multiple * n),
-                    sinf(theta * multiple * n)
-                } * radius + center;
-
-                DrawLineV(start, end, line_color);
+                UpdateTexture(canvas_texture, canvas->pixels.data());
+                DrawTexture(canvas_texture, 0, 0, WHITE);
             }
+            else if (gpu_lines)
+            {
+                DrawRecorded(border, MatrixIdentity(), line_color);
+                DrawModularChords(center, radius, lines_count, frame_multiple(frame), line_color);
+            }
+            else
+            {
+                DrawRecorded(border, MatrixIdentity(), line_color);
+                jobs.frame.wait();
+                DrawLines(points, lines_count * 2, line_color);
+            }
+
+            if (capture)
+                capture->grab();
 
-            hue += 0.5;
-            if (hue > 360)
-                hue = 0;
+            if (show_stats)
+                DrawRenderStats(10, 10);
         }
         EndDrawing();
+        UpdateRenderStats();
+    };
+
+    int result = 0;
+    if (bench)
+    {
+        result = bench_main(argc, argv, "times-table",
+                            [&](int frame, float) { draw(frame); });
+    }
+
+    while (!bench && !WindowShouldClose())
+    {
+        if (IsKeyPressed(KEY_R))
+        {
+            if (capture) capture.reset();
+            else capture = std::make_unique<FrameCapture>("times-table-frames");
+        }
+
+        if (IsKeyPressed(KEY_F1))
+            show_stats = !show_stats;
+
+        if (IsKeyPressed(KEY_G))
+            gpu_lines = !gpu_lines;
+
+        if (IsKeyPressed(KEY_S))
+            software = !software;
+
+        draw(frame);
+        ++frame;
     }
 
+    capture.reset();
+    if (canvas)
+        UnloadTexture(canvas_texture);
+    UnloadRecorded(border);
+    DisableRenderStats();
     CloseWindow();
 
-    return 0;
+    // Built with -DRAYLIB_EXT_PROFILER=ON, open in chrome://tracing
+#ifdef RAYLIB_EXT_PROFILER
+    ExportProfile("times-table-profile.json");
+#endif
+
+    return result;
 }